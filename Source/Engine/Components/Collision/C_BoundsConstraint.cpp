@@ -0,0 +1,61 @@
+#include "C_BoundsConstraint.h"
+#include "Engine/Util/XML/XML_File_Handler.h"
+
+bool C_BoundsConstraint::Serialize(pugi::xml_node* _ComponentNode)
+{
+	if (_ComponentNode == nullptr || _ComponentNode->empty())
+	{
+		return false;
+	}
+
+	pugi::xml_node behaviourNode = _ComponentNode->append_child("Behaviour");
+	XML_UTIL::SaveToXMLNode(static_cast<int>(m_behaviour), behaviourNode);
+
+	pugi::xml_node useScreenBoundsNode = _ComponentNode->append_child("UseScreenBounds");
+	XML_UTIL::SaveToXMLNode(m_useScreenBounds, useScreenBoundsNode);
+
+	pugi::xml_node boundsMinNode = _ComponentNode->append_child("BoundsMin");
+	XML_UTIL::SaveToXMLNode(m_bounds.m_min, boundsMinNode);
+
+	pugi::xml_node boundsMaxNode = _ComponentNode->append_child("BoundsMax");
+	XML_UTIL::SaveToXMLNode(m_bounds.m_max, boundsMaxNode);
+
+	return true;
+}
+
+bool C_BoundsConstraint::Load(const pugi::xml_node* _ComponentNode)
+{
+	if (_ComponentNode == nullptr || _ComponentNode->empty())
+	{
+		return false;
+	}
+
+	// Every value is optional: an empty Component reflects off the edges of the screen.
+	pugi::xml_node behaviourNode = _ComponentNode->child("Behaviour");
+	if (!behaviourNode.empty())
+	{
+		int readBehaviour = static_cast<int>(reflect);
+		XML_UTIL::LoadXMLNodeToVariable(readBehaviour, behaviourNode);
+		m_behaviour = static_cast<BoundsBehaviour>(readBehaviour);
+	}
+
+	pugi::xml_node useScreenBoundsNode = _ComponentNode->child("UseScreenBounds");
+	if (!useScreenBoundsNode.empty())
+	{
+		XML_UTIL::LoadXMLNodeToVariable(m_useScreenBounds, useScreenBoundsNode);
+	}
+
+	pugi::xml_node boundsMinNode = _ComponentNode->child("BoundsMin");
+	if (!boundsMinNode.empty())
+	{
+		XML_UTIL::LoadXMLNodeToVariable(m_bounds.m_min, boundsMinNode);
+	}
+
+	pugi::xml_node boundsMaxNode = _ComponentNode->child("BoundsMax");
+	if (!boundsMaxNode.empty())
+	{
+		XML_UTIL::LoadXMLNodeToVariable(m_bounds.m_max, boundsMaxNode);
+	}
+
+	return true;
+}
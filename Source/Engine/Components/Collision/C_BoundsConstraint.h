@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Engine/ECS/ECS_Interfaces.h"
+#include "Engine/ExternalLibraries/Pugixml/pugixml.hpp"
+#include "Engine/Physics/AABB2D.h"
+
+/// <summary>
+/// Keeps the collider of an Entity inside a rectangle. S_WorldBounds applies it to every Entity that also has a Transform and a Rigidbody.
+/// </summary>
+struct C_BoundsConstraint : IECS_Serializable
+{
+	enum BoundsBehaviour
+	{
+		reflect = 1, // Bounces off the edges, flipping the velocity.
+		clamp = 2, // Stops at the edges, losing the velocity that pushes outwards.
+	};
+
+	BoundsBehaviour m_behaviour{ reflect };
+	// The screen by default. m_bounds is only used when this is false.
+	bool m_useScreenBounds{ true };
+	AABB2D m_bounds{};
+
+	C_BoundsConstraint() {};
+	C_BoundsConstraint(BoundsBehaviour _behaviour) : m_behaviour{ _behaviour } {};
+	C_BoundsConstraint(BoundsBehaviour _behaviour, const AABB2D& _bounds) : m_behaviour{ _behaviour }, m_useScreenBounds{ false }, m_bounds{ _bounds } {};
+
+	bool Serialize(pugi::xml_node* _ComponentNode);
+	bool Load(const pugi::xml_node* _ComponentNode);
+};
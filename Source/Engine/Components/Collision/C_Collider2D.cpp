@@ -4,6 +4,60 @@
 #include "Engine/Util/Math/MyMath.h"
 #include "Engine/Util/XML/XML_File_Handler.h"
 
+C_Collider2D::C_Collider2D(const C_Collider2D& _other)
+	: m_collisionType{ _other.m_collisionType }, m_isStatic{ _other.m_isStatic }, m_Dimensions{ _other.m_Dimensions }, m_Offset{ _other.m_Offset },
+	m_uCollisionCategory{ _other.m_uCollisionCategory }, m_uCollisionMask{ _other.m_uCollisionMask }
+{
+	if (m_isStatic)
+	{
+		MarkStaticCollidersChanged();
+	}
+}
+
+C_Collider2D& C_Collider2D::operator=(const C_Collider2D& _other)
+{
+	if (m_isStatic || _other.m_isStatic)
+	{
+		MarkStaticCollidersChanged();
+	}
+
+	m_collisionType = _other.m_collisionType;
+	m_isStatic = _other.m_isStatic;
+	m_Dimensions = _other.m_Dimensions;
+	m_Offset = _other.m_Offset;
+	m_uCollisionCategory = _other.m_uCollisionCategory;
+	m_uCollisionMask = _other.m_uCollisionMask;
+
+	return *this;
+}
+
+C_Collider2D::~C_Collider2D()
+{
+	if (m_isStatic)
+	{
+		MarkStaticCollidersChanged();
+	}
+}
+
+void C_Collider2D::SetCollisionType(CollisionType_2D _newCollisionType)
+{
+	if (m_isStatic && m_collisionType != _newCollisionType)
+	{
+		MarkStaticCollidersChanged();
+	}
+
+	m_collisionType = _newCollisionType;
+}
+
+void C_Collider2D::SetStatic(bool _isStatic)
+{
+	if (m_isStatic != _isStatic)
+	{
+		m_isStatic = _isStatic;
+		MarkStaticCollidersChanged();
+	}
+}
+
 bool C_Collider2D::CheckOverlap(
 	const C_Transform2D& _thisTransform, 
 	const C_Collider2D& _otherCollider, 
@@ -46,6 +100,27 @@ bool C_Collider2D::CheckOverlap(
 	return false;
 }
 
+AABB2D C_Collider2D::GetWorldAABB(const C_Transform2D& _transform) const
+{
+	const vec2 centre = _transform.m_pos + m_Offset;
+	const vec2 dimensions = (m_Dimensions * _transform.m_scale).Absolute();
+
+	vec2 halfExtents = dimensions / 2;
+	if (GetCollisionType() == CollisionType_2D::circle)
+	{
+		// Deformed circles use the X-value of their radius, like in CheckOverlap.
+		halfExtents = vec2(halfExtents.x, halfExtents.x);
+	}
+	else if (_transform.m_rotation != 0 && _transform.m_rotation != 180)
+	{
+		const float absCos = std::abs(std::cos(static_cast<float>(_transform.m_rotation * MyMath::DegreesToRad)));
+		const float absSin = std::abs(std::sin(static_cast<float>(_transform.m_rotation * MyMath::DegreesToRad)));
+		halfExtents = vec2(absCos * halfExtents.x + absSin * halfExtents.y, absSin * halfExtents.x + absCos * halfExtents.y);
+	}
+
+	return AABB2D{ centre - halfExtents, centre + halfExtents };
+}
+
 bool C_Collider2D::Serialize(pugi::xml_node* _ComponentNode)
 {
 	if (_ComponentNode == nullptr || _ComponentNode->empty())
@@ -62,6 +137,15 @@ bool C_Collider2D::Serialize(pugi::xml_node* _ComponentNode)
 	pugi::xml_node offsetNode = _ComponentNode->append_child("Offset");
 	XML_UTIL::SaveToXMLNode(m_Offset, offsetNode);
 
+	pugi::xml_node staticNode = _ComponentNode->append_child("Static");
+	XML_UTIL::SaveToXMLNode(m_isStatic, staticNode);
+
+	pugi::xml_node categoryNode = _ComponentNode->append_child("CollisionCategory");
+	XML_UTIL::SaveToXMLNode(m_uCollisionCategory, categoryNode);
+
+	pugi::xml_node maskNode = _ComponentNode->append_child("CollisionMask");
+	XML_UTIL::SaveToXMLNode(m_uCollisionMask, maskNode);
+
 	return true;
 }
 
@@ -106,6 +190,34 @@ bool C_Collider2D::Load(const pugi::xml_node* _ComponentNode)
 		hadFailedLoads = true;
 	}
 
+	// Optional, since colliders saved before static colliders existed are all dynamic.
+	pugi::xml_node staticNode = _ComponentNode->child("Static");
+	bool isStatic = false;
+	if (!staticNode.empty())
+	{
+		XML_UTIL::LoadXMLNodeToVariable(isStatic, staticNode);
+	}
+
+	// Optional too. Colliders without them keep colliding with everything.
+	pugi::xml_node categoryNode = _ComponentNode->child("CollisionCategory");
+	if (!categoryNode.empty())
+	{
+		XML_UTIL::LoadXMLNodeToVariable(m_uCollisionCategory, categoryNode);
+	}
+
+	pugi::xml_node maskNode = _ComponentNode->child("CollisionMask");
+	if (!maskNode.empty())
+	{
+		XML_UTIL::LoadXMLNodeToVariable(m_uCollisionMask, maskNode);
+	}
+
+	// Loading also changes the shape, so a static collider always counts as changed.
+	if (m_isStatic || isStatic)
+	{
+		m_isStatic = isStatic;
+		MarkStaticCollidersChanged();
+	}
+
 	return !hadFailedLoads;
 }
 
@@ -139,13 +251,13 @@ bool C_Collider2D::Check_AABBRectangle_RotatingRectangle(const C_Collider2D& _fi
 	vec2 rotatingDimensions = (_rotatingCollider.m_Dimensions * _rotatingTransform.m_scale).Absolute();
 
 	// Point[0] = topLeft,  Point[1] = bottomLeft,  Point[2] = topRight,  Point[3] = bottomRight.
-	vec2* firstPoints = new vec2[4];
+	vec2 firstPoints[4];
 	/* topLeft */			firstPoints[0] = firstCollCentre - firstDimensions / 2;
 	/* bottomLeft */	firstPoints[1] = firstCollCentre + vec2(firstDimensions.x / -2, firstDimensions.y / 2);
 	/* topRight */		firstPoints[2] = firstCollCentre * 2 - firstPoints[1]; // == point_centre + (V_Corner->Centre) 
 	/* bottomRight */ firstPoints[3] = firstCollCentre * 2 - firstPoints[0];
 
-	vec2* rotatingPoints = new vec2[4];
+	vec2 rotatingPoints[4];
 	/* topLeft */			rotatingPoints[0] = rotatingCollCentre + ( rotatingDimensions / -2).RotateBy(_rotatingTransform.m_rotation * MyMath::DegreesToRad);
 	/* bottomLeft */	rotatingPoints[1] = rotatingCollCentre + vec2(rotatingDimensions.x / -2, rotatingDimensions.y / 2).RotateBy(_rotatingTransform.m_rotation * MyMath::DegreesToRad);
 	/* topRight */		rotatingPoints[2] = rotatingCollCentre * 2 - rotatingPoints[1]; // == point_centre + (V_Corner->Centre) 
@@ -159,8 +271,6 @@ bool C_Collider2D::Check_AABBRectangle_RotatingRectangle(const C_Collider2D& _fi
 
 	if (firstPoints[0].x > rotatingMaxX || firstPoints[3].x < rotatingMinX || firstPoints[0].y > rotatingMaxY || firstPoints[3].y < rotatingMinY)
 	{
-		delete[] firstPoints;
-		delete[] rotatingPoints;
 		return false;
 	}
 
@@ -173,8 +283,6 @@ bool C_Collider2D::Check_AABBRectangle_RotatingRectangle(const C_Collider2D& _fi
 		if (!INTERNAL_Check_SAT_Collision_AlongAxis(firstPoints[a] - firstPoints[0], firstPoints, 4, rotatingPoints, 4))
 		{
 			// If our SAT-Collision breaks at any point, there is no collision between both pieces.
-			delete[] firstPoints;
-			delete[] rotatingPoints;
 			return false;
 		}
 	}
@@ -185,15 +293,11 @@ bool C_Collider2D::Check_AABBRectangle_RotatingRectangle(const C_Collider2D& _fi
 		if (!INTERNAL_Check_SAT_Collision_AlongAxis(rotatingPoints[b] - rotatingPoints[0], firstPoints, 4, rotatingPoints, 4))
 		{
 			// If our SAT-Collision breaks at any point, there is no collision between both pieces.
-			delete[] firstPoints;
-			delete[] rotatingPoints;
 			return false;
 		}
 	}
 
 	// If at all points the collision existed, both squares are colliding.
-	delete[] firstPoints;
-	delete[] rotatingPoints;
 	return true;
 }
 
@@ -283,13 +387,13 @@ bool C_Collider2D::Check_RotatingRectangle_RotatingRectangle(const C_Collider2D&
 	vec2 otherDimensions = (_otherCollider.m_Dimensions * _otherTransform.m_scale).Absolute();
 
 	// Point[0] = topLeft,  Point[1] = bottomLeft,  Point[2] = topRight,  Point[3] = bottomRight.
-	vec2* firstPoints = new vec2[4];
+	vec2 firstPoints[4];
 	/* topLeft */			firstPoints[0] = firstCollCentre + (firstDimensions / -2).RotateBy(_firstTransform.m_rotation * MyMath::DegreesToRad);
 	/* bottomLeft */	firstPoints[1] = firstCollCentre + vec2(firstDimensions.x / -2, firstDimensions.y / 2).RotateBy(_firstTransform.m_rotation * MyMath::DegreesToRad);
 	/* topRight */		firstPoints[2] = firstCollCentre * 2 - firstPoints[1]; // Centre + (centre - corner)
 	/* bottomRight */	firstPoints[3] = firstCollCentre * 2 - firstPoints[0];
 
-	vec2* otherPoints = new vec2[4];
+	vec2 otherPoints[4];
 	/* topLeft */			otherPoints[0] = otherCollCentre + (otherDimensions / -2).RotateBy(_otherTransform.m_rotation * MyMath::DegreesToRad);
 	/* bottomLeft */	otherPoints[1] = otherCollCentre + vec2(otherDimensions.x / -2, otherDimensions.y / 2).RotateBy(_otherTransform.m_rotation * MyMath::DegreesToRad);
 	/* topRight */		otherPoints[2] = otherCollCentre * 2 - otherPoints[1]; // Centre + (centre - corner)
@@ -305,8 +409,6 @@ bool C_Collider2D::Check_RotatingRectangle_RotatingRectangle(const C_Collider2D&
 
 	if (firstMinX > otherMaxX || firstMaxX < otherMinX || firstMinY > otherMaxY || firstMaxY < otherMinY)
 	{
-		delete[] firstPoints;
-		delete[] otherPoints;
 		return false;
 	}
 
@@ -319,8 +421,6 @@ bool C_Collider2D::Check_RotatingRectangle_RotatingRectangle(const C_Collider2D&
 		if (!INTERNAL_Check_SAT_Collision_AlongAxis(firstPoints[a] - firstPoints[0], firstPoints, 4, otherPoints, 4))
 		{
 			// If our SAT-Collision breaks at any point, there is no collision between both pieces.
-			delete[] firstPoints;
-			delete[] otherPoints;
 			return false;
 		}
 	}
@@ -331,16 +431,11 @@ bool C_Collider2D::Check_RotatingRectangle_RotatingRectangle(const C_Collider2D&
 		if (!INTERNAL_Check_SAT_Collision_AlongAxis(otherPoints[b] - otherPoints[0], firstPoints, 4, otherPoints, 4))
 		{
 			// If our SAT-Collision breaks at any point, there is no collision between both pieces.
-			delete[] firstPoints;
-			delete[] otherPoints;
 			return false;
 		}
 	}
 
 	// If at all points the collision existed, both squares are colliding.
-
-	delete[] firstPoints;
-	delete[] otherPoints;
 	return true;
 }
 
@@ -3,6 +3,10 @@
 #include "Engine/DataTypes/Vectors/vector2d.h"
 #include "Engine/ECS/ECS_Interfaces.h"
 #include "Engine/ExternalLibraries/Pugixml/pugixml.hpp"
+#include "Engine/Physics/AABB2D.h"
+#include "Engine/Physics/CollisionFilter.h"
+#include <atomic>
+#include <cstdint>
 
 struct C_Transform2D;
 
@@ -17,21 +21,47 @@ struct C_Collider2D : IECS_Serializable
 
 private:
 	CollisionType_2D m_collisionType { rectangle };
+	// Static colliders never move. The broadphase keeps them in a tree that is only rebuilt when StaticCollidersVersion changes.
+	bool m_isStatic{ false };
+
+	static inline std::atomic<uint32_t> StaticCollidersVersion{ 0 };
 
 public:
 	vec2 m_Dimensions{ 1,1 };
 	vec2 m_Offset{ 0,0 };
+	// Bits of the categories this collider belongs to, and of the ones it collides with. By default, everything collides with everything.
+	// Static colliders cache them in the broadphase: call MarkStaticCollidersChanged after changing them.
+	uint32_t m_uCollisionCategory{ 1 };
+	uint32_t m_uCollisionMask{ 0xFFFFFFFF };
 
 	C_Collider2D() {};
-	C_Collider2D(CollisionType_2D _collisionType, vec2 _dimensions = vec2(1, 1), vec2 _offset = vec2(0, 0))
-		: m_collisionType {_collisionType}, m_Dimensions{ _dimensions }, m_Offset{ _offset }
-	{}
+	C_Collider2D(CollisionType_2D _collisionType, vec2 _dimensions = vec2(1, 1), vec2 _offset = vec2(0, 0), bool _isStatic = false)
+		: m_collisionType {_collisionType}, m_isStatic{ _isStatic }, m_Dimensions{ _dimensions }, m_Offset{ _offset }
+	{ if (m_isStatic) { MarkStaticCollidersChanged(); } }
+	C_Collider2D(const C_Collider2D& _other);
+	C_Collider2D& operator=(const C_Collider2D& _other);
+	~C_Collider2D();
 
 	// Public Methods
 	inline CollisionType_2D GetCollisionType() const { return m_collisionType; };
-	inline void SetCollisionType(CollisionType_2D _newCollisionType) { m_collisionType = _newCollisionType; };
+	void SetCollisionType(CollisionType_2D _newCollisionType);
+	inline bool IsStatic() const { return m_isStatic; };
+	void SetStatic(bool _isStatic);
+	inline CollisionFilter GetCollisionFilter() const { return CollisionFilter{ m_uCollisionCategory, m_uCollisionMask }; };
+	inline bool CanCollideWith(const C_Collider2D& _other) const { return GetCollisionFilter().CanCollideWith(_other.GetCollisionFilter()); };
+
+	/// <summary>
+	/// Changes every time a static collider is created, destroyed or modified through its setters.
+	/// Moving a static collider through its Transform is not detected: make it dynamic first.
+	/// </summary>
+	static inline uint32_t GetStaticCollidersVersion() { return StaticCollidersVersion.load(std::memory_order_acquire); };
+	static inline void MarkStaticCollidersChanged() { StaticCollidersVersion.fetch_add(1, std::memory_order_acq_rel); };
 
 	bool CheckOverlap(const C_Transform2D& _thisTransform, const C_Collider2D& _otherCollider, const C_Transform2D& _otherTransform) const;
+	/// <summary>
+	/// Smallest axis-aligned box that contains the collider, rotation included. Used by the broadphase.
+	/// </summary>
+	AABB2D GetWorldAABB(const C_Transform2D& _transform) const;
 
 	bool Serialize(pugi::xml_node* _ComponentNode);
 	bool Load(const pugi::xml_node* _ComponentNode);
@@ -3,6 +3,8 @@
 #include "Engine/EngineConfiguration.h"
 #include "Engine/Engine.h"
 #include "Engine/Util/XML/XML_File_Handler.h"
+#include "Engine/Util/Memory/Memory_Util.h"
+#include "Engine/Rendering/RenderQueue.h"
 #include "Engine/Components/Transform/C_Transform2D.h"
 #include "Engine/Components/Transform/C_Transform2D_PlusParenting.h"
 
@@ -10,7 +12,7 @@ void C_TextureRenderer::SetImageAsset(const std::string& _ImagePath)
 {
 	if (m_pImage != nullptr)
 	{
-		tigrFree(m_pImage);
+		RenderQueue::ReleaseTexture(m_pImage);
 		m_pImage = nullptr;
 		TextureFilePath.clear();
 	}
@@ -46,14 +48,13 @@ void C_TextureRenderer::Render(const C_Transform2D* _transform) const
 	const Engine* engine = Engine::GetInstance();
 	Tigr* window = engine->GetTigrScreen();
 
-	if (m_visible == false || m_pImage == nullptr || window == nullptr)
+	RenderCommand command;
+	if (window == nullptr || !BuildRenderCommand(_transform, command))
 	{
 		return;
 	}
 
-	tigrBlitTint(window, m_pImage, _transform->m_pos.x, _transform->m_pos.y,
-	 	m_u0 * m_uWidth, m_v0 * m_uHeight, (m_u1 - m_u0) * m_uWidth, (m_v1 - m_v0) * m_uHeight,
-		TPixel(m_tintColor.x, m_tintColor.y, m_tintColor.z, m_tintColor.w));
+	RenderQueue::SubmitCommand(window, command);
 }
 
 void C_TextureRenderer::Render(const C_Transform2D_PlusParenting* _transform) const
@@ -82,6 +83,26 @@ void C_TextureRenderer::Render(const C_Transform2D_PlusParenting* _transform) co
 		TPixel(m_tintColor.x / 255.0f, m_tintColor.y / 255.0f, m_tintColor.z / 255.0f, m_tintColor.w / 255.0f));
 }
 
+bool C_TextureRenderer::BuildRenderCommand(const C_Transform2D* _transform, RenderCommand& _command) const
+{
+	if (_transform == nullptr || m_visible == false || m_pImage == nullptr)
+	{
+		return false;
+	}
+
+	_command.m_pTexture = m_pImage;
+	_command.m_destinationX = static_cast<int>(_transform->m_pos.x);
+	_command.m_destinationY = static_cast<int>(_transform->m_pos.y);
+	_command.m_sourceX = static_cast<int>(m_u0 * m_uWidth);
+	_command.m_sourceY = static_cast<int>(m_v0 * m_uHeight);
+	_command.m_sourceWidth = static_cast<int>((m_u1 - m_u0) * m_uWidth);
+	_command.m_sourceHeight = static_cast<int>((m_v1 - m_v0) * m_uHeight);
+	_command.m_tint = TPixel{ static_cast<unsigned char>(m_tintColor.x), static_cast<unsigned char>(m_tintColor.y), static_cast<unsigned char>(m_tintColor.z), static_cast<unsigned char>(m_tintColor.w) };
+	_command.m_layer = m_layer;
+
+	return true;
+}
+
 void C_TextureRenderer::SetTintColor(const float _r, const float _g, const float _b, const float _a)
 {
 	m_tintColor = Color(_r, _g, _b, _a);
@@ -95,6 +116,18 @@ void C_TextureRenderer::SetDrawingPositionInTexture(float _u0, float _u1, float
 	m_v1 = _v1;
 }
 
+size_t C_TextureRenderer::GetHeapMemoryUsage() const
+{
+	size_t heapMemory = MEMORY_UTIL::GetHeapMemoryUsage(TextureFilePath);
+
+	if (m_pImage != nullptr)
+	{
+		heapMemory += sizeof(Tigr) + static_cast<size_t>(m_pImage->w) * m_pImage->h * sizeof(TPixel);
+	}
+
+	return heapMemory;
+}
+
 C_TextureRenderer::C_TextureRenderer(const std::string& _ImagePath)
 {
 	SetImageAsset(_ImagePath);
@@ -104,7 +137,7 @@ C_TextureRenderer::~C_TextureRenderer()
 {
 	if (m_pImage != nullptr)
 	{
-		tigrFree(m_pImage);
+		RenderQueue::ReleaseTexture(m_pImage);
 		m_pImage = nullptr;
 		TextureFilePath.clear();
 	}
@@ -126,6 +159,9 @@ bool C_TextureRenderer::Serialize(pugi::xml_node* _ComponentNode)
 	pugi::xml_node tintColorNode = _ComponentNode->append_child("TintColor");
 	XML_UTIL::SaveToXMLNode(m_tintColor, tintColorNode);
 
+	pugi::xml_node layerNode = _ComponentNode->append_child("Layer");
+	XML_UTIL::SaveToXMLNode(m_layer, layerNode);
+
 	pugi::xml_node coordinatesNode = _ComponentNode->append_child("TextureCoordinates");
 
 	pugi::xml_node u0CoordinatesNode = coordinatesNode.append_child("u0");
@@ -182,6 +218,13 @@ bool C_TextureRenderer::Load(const pugi::xml_node* _ComponentNode)
 		hadFailedLoads = true;
 	}
 
+	// The Layer is optional, files saved before it existed render on layer 0.
+	pugi::xml_node layerNode = _ComponentNode->child("Layer");
+	if (!layerNode.empty())
+	{
+		XML_UTIL::LoadXMLNodeToVariable(m_layer, layerNode);
+	}
+
 	pugi::xml_node coordinatesNode = _ComponentNode->child("TextureCoordinates");
 
 	pugi::xml_node u0CoordinatesNode = coordinatesNode.child("u0");
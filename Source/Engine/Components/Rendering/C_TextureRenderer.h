@@ -6,10 +6,11 @@
 #include <string>
 
 struct Tigr;
+struct RenderCommand;
 struct C_Transform2D;
 struct C_Transform2D_PlusParenting;
 
-struct C_TextureRenderer : IECS_Serializable, IECS_Render
+struct C_TextureRenderer : IECS_Serializable, IECS_Render, IECS_HeapMemory
 {
 private:
 	bool m_visible{ true };
@@ -29,6 +30,8 @@ private:
 
 	vec4 m_tintColor{ vec4(255.0f, 255.0f, 255.0f, 255.0f)};
 
+	int m_layer{ 0 }; // Renderers on lower layers are drawn first.
+
 public:
 	C_TextureRenderer() {};
 	C_TextureRenderer(const std::string& _ImagePath);
@@ -42,11 +45,20 @@ public:
 	inline void SetVisibility(const bool _Visible) { m_visible = _Visible; };
 	inline bool GetVisibility() const { return m_visible; };
 
+	inline void SetLayer(const int _layer) { m_layer = _layer; };
+	inline int GetLayer() const { return m_layer; };
+
 	void Render(const C_Transform2D* _transform) const;
 	void Render(const C_Transform2D_PlusParenting* _transform) const;
+	/// <summary>
+	/// Fills the blit that Render would do. Returns false if there is nothing to draw.
+	/// </summary>
+	bool BuildRenderCommand(const C_Transform2D* _transform, RenderCommand& _command) const;
 
 	void SetTintColor(const float _r, const float _g, const float _b, const float _a);
 
+	size_t GetHeapMemoryUsage() const;
+
 	bool Serialize(pugi::xml_node* _ComponentNode);
 	bool Load(const pugi::xml_node* _ComponentNode);
 };
@@ -23,6 +23,33 @@ void C_Transform2D::SetPosition(vec2 _position)
 	m_pos = _position;
 }
 
+void C_Transform2D::Teleport(vec2 _position)
+{
+	m_pos = _position;
+	m_previousPos = _position;
+}
+
+C_Transform2D C_Transform2D::GetInterpolated(float _alpha) const
+{
+	C_Transform2D interpolated{ *this };
+	interpolated.m_pos = m_previousPos + (m_pos - m_previousPos) * _alpha;
+
+	// Rotating through the shortest side.
+	float rotationDifference = m_rotation - m_previousRotation;
+	if (rotationDifference > 180)
+	{
+		rotationDifference -= 360;
+	}
+	else if (rotationDifference < -180)
+	{
+		rotationDifference += 360;
+	}
+	interpolated.SetRotation(m_previousRotation + rotationDifference * _alpha);
+
+	interpolated.StorePreviousState();
+	return interpolated;
+}
+
 void C_Transform2D::SetRotation(float _rotation)
 {
 	if (_rotation >= 0 && _rotation < 360)
@@ -58,16 +85,19 @@ void C_Transform2D::SetRotation(vec2 _orientation)
 C_Transform2D::C_Transform2D(vec2 _position, float _rotation) : m_pos{ _position }, m_rotation{ _rotation }
 {
 	SetRotation(_rotation);
+	StorePreviousState();
 }
 
 C_Transform2D::C_Transform2D(vec2 _position, float _rotation, vec2 _scale) : m_pos{ _position }, m_scale{ _scale }
 {
 	SetRotation(_rotation);
+	StorePreviousState();
 }
 
 C_Transform2D::C_Transform2D(vec2 _position, vec2 _orientation, vec2 _scale) : m_pos{ _position }, m_scale{ _scale }
 {
 	SetRotation(_orientation);
+	StorePreviousState();
 }
 
 bool C_Transform2D::Serialize(pugi::xml_node* _ComponentNode) const
@@ -105,6 +135,9 @@ bool C_Transform2D::Load(const pugi::xml_node* _ComponentNode)
 	pugi::xml_node scaleNode = _ComponentNode->child("Scale");
 	XML_UTIL::LoadXMLNodeToVariable(m_scale, scaleNode);
 
+	// A loaded Transform starts where it was loaded, without interpolating from its default values.
+	StorePreviousState();
+
 	return true;
 }
 
@@ -15,6 +15,10 @@ struct C_Transform2D : IECS_Transform, IECS_Serializable
 	float m_rotation{ 0 };
 	vec2 m_scale{ ENTITY_BASE_SCALE };
 
+	// State at the beginning of the last fixed step, used to interpolate the rendering between steps.
+	vec2 m_previousPos{ m_pos };
+	float m_previousRotation{ m_rotation };
+
 	// Constructors
 	C_Transform2D() {}
 	C_Transform2D(vec2 _position) : m_pos{ _position } {}
@@ -29,6 +33,16 @@ struct C_Transform2D : IECS_Transform, IECS_Serializable
 	void SetRotation(float _rotation);
 	void SetRotation(vec2 _orientation);
 	inline void AddDisplacement(const vec2& _position) { m_pos = m_pos + _position; };
+	/// <summary>
+	/// Moves the Transform without interpolating the rendering from its old position.
+	/// </summary>
+	void Teleport(vec2 _position);
+
+	inline void StorePreviousState() { m_previousPos = m_pos; m_previousRotation = m_rotation; };
+	/// <summary>
+	/// Copy of this Transform placed between the previous state (_alpha = 0) and the current one (_alpha = 1).
+	/// </summary>
+	C_Transform2D GetInterpolated(float _alpha) const;
 
 	bool Serialize(pugi::xml_node* _ComponentNode) const;
 	bool Load(const pugi::xml_node* _ComponentNode);
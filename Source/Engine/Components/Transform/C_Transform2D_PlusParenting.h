@@ -2,9 +2,10 @@
 
 #include "Engine/Components/Transform/C_Transform2D.h"
 #include "Engine/EngineConfiguration.h"
+#include "Engine/Util/Memory/Memory_Util.h"
 #include <vector>
 
-struct C_Transform2D_PlusParenting : public C_Transform2D
+struct C_Transform2D_PlusParenting : public C_Transform2D, IECS_HeapMemory
 {
 protected:
 	C_Transform2D_PlusParenting* m_pParent{ nullptr };
@@ -24,6 +25,7 @@ public:
 	void AddChild(C_Transform2D_PlusParenting* _pChildTransform);
 	void RemoveChild(C_Transform2D_PlusParenting* _pChildTransform);
 	size_t NumberOfChildren() const;
+	inline size_t GetHeapMemoryUsage() const { return MEMORY_UTIL::GetHeapMemoryUsage(m_pChildren); };
 
 	C_Transform2D_PlusParenting* TryGetChild(size_t _uChildIndex) const;
 	C_Transform2D_PlusParenting* INTERNAL_GetChildWithoutChecks(size_t _uChildIndex) const;
@@ -137,10 +137,11 @@ bool Prefab::SaveEntityToFile(const EntityID& _entityID)
 	}
 
 	// Setting the entityPool name.
-	pugi::xml_node poolNode = poolManager->GetPoolListNode().find_child_by_attribute("PoolID", std::to_string(ECS::GetPoolFromId(_entityID)).c_str());
+	const ECS_PoolManifest& poolManifest = poolManager->GetPoolManifest();
+	const ECS_PoolManifest::PoolEntry* poolEntry = poolManifest.FindPoolById(ECS::GetPoolFromId(_entityID));
 	pugi::xml_node parentNode = PrefabInfo.child("Prefab");
 	
-	if (poolNode.empty() || parentNode.empty())
+	if (poolEntry == nullptr || parentNode.empty())
 	{
 		return false;
 	}
@@ -148,7 +149,7 @@ bool Prefab::SaveEntityToFile(const EntityID& _entityID)
 	// we reset the Parent Node, in case we need to override previous changes.
 	parentNode.remove_children();
 	parentNode.remove_attributes();
-	parentNode.append_attribute("PoolName").set_value(poolNode.attribute("PoolName").value());
+	parentNode.append_attribute("PoolName").set_value(std::string(poolManifest.GetPoolName(poolEntry)).c_str());
 
 	// Saving the Components of this entity.
 	ECS_EntityPool* entityPool = poolManager->GetEntityPool(ECS::GetPoolFromId(_entityID));
@@ -164,14 +165,13 @@ bool Prefab::SaveEntityToFile(const EntityID& _entityID)
 	{
 		if (entityComponentMask.test(compIndex))
 		{
-			pugi::xml_node componentInPoolList = poolNode.child("Components").find_child_by_attribute("ComponentIndex", std::to_string(compIndex).c_str());
+			std::string componentName = std::string(poolManifest.GetComponentName(poolEntry, compIndex));
 
-			if (componentInPoolList.empty())
+			if (componentName.empty())
 			{
 				continue;
 			}
 
-			std::string componentName = componentInPoolList.attribute("ComponentName").value();
 			pugi::xml_node component = componentsNode.append_child("Component");
 			component.append_attribute("ComponentName").set_value(componentName.c_str());
 
@@ -212,15 +212,17 @@ EntityID Prefab::Instantiate() const
 
 	pugi::xml_node parentNode = PrefabInfo.child("Prefab");
 	pugi::xml_node componentsNode = parentNode.child("ListOfComponents");
-	pugi::xml_node poolNode = poolManager->GetPoolListNode().find_child_by_attribute("PoolName", parentNode.attribute("PoolName").value());
-	pugi::xml_node poolComponentsNode = poolNode.child("Components");
 
-	if (parentNode.empty() || componentsNode.empty() || poolNode.empty() || poolComponentsNode.empty())
+	// Pools and Component Indexes are looked up in the binary manifest, instead of walking the Pool Info DOM.
+	const ECS_PoolManifest& poolManifest = poolManager->GetPoolManifest();
+	const ECS_PoolManifest::PoolEntry* poolEntry = poolManifest.FindPoolByName(parentNode.attribute("PoolName").value());
+
+	if (parentNode.empty() || componentsNode.empty() || poolEntry == nullptr)
 	{
 		return ECS::CONSTANTS::InvalidEntityID();
 	}
 
-	ECS_EntityPool* entityPool = poolManager->GetEntityPool(static_cast<PoolID>(std::stof(poolNode.attribute("PoolID").value())));
+	ECS_EntityPool* entityPool = poolManager->GetEntityPool(poolEntry->m_poolId);
 	if (entityPool == nullptr)
 	{
 		return ECS::CONSTANTS::InvalidEntityID();
@@ -230,10 +232,12 @@ EntityID Prefab::Instantiate() const
 
 	for (auto componentNode : componentsNode.children("Component"))
 	{
-		pugi::xml_node componentInPoolDoc = poolComponentsNode.find_child_by_attribute("ComponentName", componentNode.attribute("ComponentName").value());
-		auto componentIndexStr = componentInPoolDoc.attribute("ComponentIndex").value();
-		ComponentIndex componentIndex = static_cast<ComponentIndex>(std::stof(componentIndexStr));
-	
+		ComponentIndex componentIndex = poolManifest.FindComponentIndex(poolEntry, componentNode.attribute("ComponentName").value());
+		if (componentIndex == ECS::CONSTANTS::InvalidComponentIndex())
+		{
+			continue; // This Pool doesn't have that Component anymore.
+		}
+
 		void* instantiatedComponent = entityPool->AssignComponent(ECS::GetIndexFromId(entityID), componentIndex);
 
 		if (instantiatedComponent != nullptr && !componentNode.children().empty())
@@ -0,0 +1,110 @@
+#include "ECS_BehaviourScheduler.h"
+
+#pragma region Behaviour
+
+ECS_Behaviour& ECS_Behaviour::operator=(ECS_Behaviour&& _other) noexcept
+{
+	if (this != &_other)
+	{
+		Stop();
+		m_handle = _other.m_handle;
+		_other.m_handle = nullptr;
+	}
+
+	return *this;
+}
+
+void ECS_Behaviour::Stop()
+{
+	if (!m_handle)
+	{
+		return;
+	}
+
+	if (ECS_BehaviourScheduler* scheduler = m_handle.promise().m_pScheduler)
+	{
+		scheduler->Cancel(m_handle);
+	}
+
+	m_handle.destroy();
+	m_handle = nullptr;
+}
+
+void WaitSeconds::await_suspend(std::coroutine_handle<ECS_Behaviour::promise_type> _handle) const
+{
+	ECS_BehaviourScheduler* scheduler = _handle.promise().m_pScheduler;
+	scheduler->Schedule(_handle, scheduler->GetCurrentTime() + m_seconds);
+}
+
+void NextFrame::await_suspend(std::coroutine_handle<ECS_Behaviour::promise_type> _handle) const
+{
+	ECS_BehaviourScheduler* scheduler = _handle.promise().m_pScheduler;
+	scheduler->Schedule(_handle, scheduler->GetCurrentTime());
+}
+
+#pragma endregion
+
+#pragma region Behaviour Scheduler
+
+ECS_BehaviourScheduler::~ECS_BehaviourScheduler()
+{
+	assert(m_scheduledTickets.empty() && "Destroying the Behaviour Scheduler while some Behaviours are still alive.");
+}
+
+void ECS_BehaviourScheduler::Start(ECS_Behaviour& _behaviour)
+{
+	if (!_behaviour.m_handle || _behaviour.m_handle.done())
+	{
+		assert(false && "Trying to start a Behaviour that is empty or already finished.");
+		return;
+	}
+	if (_behaviour.m_handle.promise().m_pScheduler != nullptr)
+	{
+		assert(false && "Trying to start a Behaviour that was already started.");
+		return;
+	}
+
+	_behaviour.m_handle.promise().m_pScheduler = this;
+	Schedule(_behaviour.m_handle, m_currentTime);
+}
+
+void ECS_BehaviourScheduler::Update(float _deltaTime)
+{
+	m_currentTime += _deltaTime;
+
+	// Taking the Behaviours out first, so the ones that suspend again while being resumed don't wake up twice in the same Update.
+	m_wakingBehaviours.clear();
+	while (!m_sleepingBehaviours.empty() && m_sleepingBehaviours.top().m_wakeTime <= m_currentTime)
+	{
+		m_wakingBehaviours.push_back(m_sleepingBehaviours.top());
+		m_sleepingBehaviours.pop();
+	}
+
+	for (const ScheduledBehaviour& behaviour : m_wakingBehaviours)
+	{
+		// A Behaviour resumed before this one may have destroyed it.
+		auto scheduledTicket = m_scheduledTickets.find(behaviour.m_handle.address());
+		if (scheduledTicket == m_scheduledTickets.end() || scheduledTicket->second != behaviour.m_uTicket)
+		{
+			continue;
+		}
+
+		m_scheduledTickets.erase(scheduledTicket);
+		behaviour.m_handle.resume();
+	}
+}
+
+void ECS_BehaviourScheduler::Schedule(std::coroutine_handle<ECS_Behaviour::promise_type> _handle, double _wakeTime)
+{
+	const uint64_t ticket = m_uNextTicket++;
+	m_scheduledTickets[_handle.address()] = ticket;
+	m_sleepingBehaviours.push(ScheduledBehaviour{ _wakeTime, ticket, _handle });
+}
+
+void ECS_BehaviourScheduler::Cancel(std::coroutine_handle<ECS_Behaviour::promise_type> _handle)
+{
+	// The heap entry stays until its wake time, and is skipped because its ticket is no longer registered.
+	m_scheduledTickets.erase(_handle.address());
+}
+
+#pragma endregion
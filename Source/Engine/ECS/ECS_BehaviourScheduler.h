@@ -0,0 +1,133 @@
+#pragma once
+
+#include <assert.h>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+class ECS_BehaviourScheduler;
+
+/// <summary>
+/// Coroutine owned by a Component. Write a member function that returns ECS_Behaviour and uses co_await WaitSeconds(x) or co_await NextFrame(),
+/// store the result in the Component and pass it to ECS_PoolManager::StartBehaviour.
+/// <para>Destroying the ECS_Behaviour (usually together with its Component) stops the coroutine, even while it's waiting.
+/// A coroutine must not destroy its own ECS_Behaviour while it's running.</para>
+/// </summary>
+class ECS_Behaviour
+{
+public:
+	struct promise_type
+	{
+		ECS_BehaviourScheduler* m_pScheduler{ nullptr };
+
+		ECS_Behaviour get_return_object() { return ECS_Behaviour(std::coroutine_handle<promise_type>::from_promise(*this)); };
+		// Behaviours don't run until they are started, and they stay alive after finishing until their owner destroys them.
+		std::suspend_always initial_suspend() noexcept { return {}; };
+		std::suspend_always final_suspend() noexcept { return {}; };
+		void return_void() {};
+		void unhandled_exception()
+		{
+			assert(false && "A Behaviour threw an exception.");
+			std::terminate();
+		};
+	};
+
+private:
+	std::coroutine_handle<promise_type> m_handle;
+
+	explicit ECS_Behaviour(std::coroutine_handle<promise_type> _handle) : m_handle{ _handle } {};
+
+public:
+	ECS_Behaviour() {};
+	ECS_Behaviour(const ECS_Behaviour&) = delete;
+	ECS_Behaviour& operator=(const ECS_Behaviour&) = delete;
+	ECS_Behaviour(ECS_Behaviour&& _other) noexcept : m_handle{ _other.m_handle } { _other.m_handle = nullptr; };
+	ECS_Behaviour& operator=(ECS_Behaviour&& _other) noexcept;
+	~ECS_Behaviour() { Stop(); };
+
+	inline bool IsValid() const { return static_cast<bool>(m_handle); };
+	inline bool IsRunning() const { return m_handle && m_handle.promise().m_pScheduler != nullptr && !m_handle.done(); };
+	inline bool IsFinished() const { return m_handle && m_handle.done(); };
+
+	/// <summary>
+	/// Cancels the coroutine and releases it.
+	/// </summary>
+	void Stop();
+
+	friend class ECS_BehaviourScheduler;
+};
+
+/// <summary>
+/// co_await WaitSeconds(x) resumes the Behaviour once x seconds of game time have passed.
+/// </summary>
+struct WaitSeconds
+{
+	float m_seconds{ 0 };
+
+	explicit WaitSeconds(float _seconds) : m_seconds{ _seconds } {};
+
+	inline bool await_ready() const noexcept { return false; };
+	void await_suspend(std::coroutine_handle<ECS_Behaviour::promise_type> _handle) const;
+	inline void await_resume() const noexcept {};
+};
+
+/// <summary>
+/// co_await NextFrame() resumes the Behaviour in the next Behaviour update.
+/// </summary>
+struct NextFrame
+{
+	inline bool await_ready() const noexcept { return false; };
+	void await_suspend(std::coroutine_handle<ECS_Behaviour::promise_type> _handle) const;
+	inline void await_resume() const noexcept {};
+};
+
+/// <summary>
+/// Resumes the suspended Behaviours when their wake time comes. They are kept in a heap sorted by wake time,
+/// so the cost of an update depends on how many Behaviours wake up, not on how many are sleeping.
+/// <para>Behaviours are resumed on the thread that calls Update, in wake time order.</para>
+/// </summary>
+class ECS_BehaviourScheduler
+{
+	struct ScheduledBehaviour
+	{
+		double m_wakeTime{ 0 };
+		uint64_t m_uTicket{ 0 }; // Unique per scheduling. Also keeps Behaviours with the same wake time in scheduling order.
+		std::coroutine_handle<ECS_Behaviour::promise_type> m_handle;
+
+		inline bool operator>(const ScheduledBehaviour& _other) const
+			{ return m_wakeTime != _other.m_wakeTime ? m_wakeTime > _other.m_wakeTime : m_uTicket > _other.m_uTicket; };
+	};
+
+	std::priority_queue<ScheduledBehaviour, std::vector<ScheduledBehaviour>, std::greater<ScheduledBehaviour>> m_sleepingBehaviours;
+	// Ticket of the last scheduling of every suspended coroutine. Heap entries whose ticket doesn't match were cancelled.
+	std::unordered_map<void*, uint64_t> m_scheduledTickets;
+	std::vector<ScheduledBehaviour> m_wakingBehaviours;
+
+	double m_currentTime{ 0 };
+	uint64_t m_uNextTicket{ 0 };
+
+public:
+	ECS_BehaviourScheduler() {};
+	ECS_BehaviourScheduler(const ECS_BehaviourScheduler&) = delete;
+	ECS_BehaviourScheduler& operator=(const ECS_BehaviourScheduler&) = delete;
+	~ECS_BehaviourScheduler();
+
+	/// <summary>
+	/// The Behaviour runs for the first time in the next Update.
+	/// </summary>
+	void Start(ECS_Behaviour& _behaviour);
+	/// <summary>
+	/// Advances the time and resumes every Behaviour whose wake time has come. Behaviours suspended during this Update wake up in the next one at the earliest.
+	/// </summary>
+	void Update(float _deltaTime);
+
+	inline double GetCurrentTime() const { return m_currentTime; };
+	inline unsigned int HowManySleepingBehaviours() const { return static_cast<unsigned int>(m_scheduledTickets.size()); };
+
+	// Used by the awaitables and by ECS_Behaviour.
+	void Schedule(std::coroutine_handle<ECS_Behaviour::promise_type> _handle, double _wakeTime);
+	void Cancel(std::coroutine_handle<ECS_Behaviour::promise_type> _handle);
+};
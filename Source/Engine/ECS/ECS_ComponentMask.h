@@ -0,0 +1,269 @@
+#pragma once
+
+#include <assert.h>
+#include <bit>
+#include <cstdint>
+
+// Picking the widest instruction set the compiler has been allowed to use.
+// MSVC only defines __AVX__ / __AVX2__ (through /arch), and SSE2 is always available on x64.
+#if defined(__AVX2__) || defined(__AVX__)
+#include <immintrin.h>
+#define ECS_COMPONENT_MASK_USE_AVX
+#define ECS_COMPONENT_MASK_USE_SSE41
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#define ECS_COMPONENT_MASK_USE_SSE41
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ECS_COMPONENT_MASK_USE_SSE2
+#endif
+
+/// <summary>
+/// Fixed-size bitmask used to store which components an Entity Pool or an Entity has.
+/// <para>It keeps the std::bitset interface the ECS already used (test, set, reset, any, none, count),
+/// but its storage is a plain array of 64-bit words, so subset, any and none checks compile to SSE / AVX instructions.</para>
+/// </summary>
+template<unsigned int NumberOfBits>
+struct ECS_ComponentMask
+{
+	static_assert(NumberOfBits == 32 || NumberOfBits == 64 || NumberOfBits == 128 || NumberOfBits == 256 || NumberOfBits == 512,
+		"Component masks can only be 32, 64, 128, 256 or 512 bits wide.");
+
+	static constexpr unsigned int NumberOfWords = (NumberOfBits + 63) / 64;
+
+	uint64_t m_words[NumberOfWords]{};
+
+#pragma region Bit Access
+
+	static constexpr unsigned int size() { return NumberOfBits; };
+
+	inline bool test(const unsigned int _bit) const
+	{
+		assert(_bit < NumberOfBits && "Trying to test a bit outside of the Component Mask.");
+		return (m_words[_bit >> 6] >> (_bit & 63)) & 1u;
+	}
+	inline ECS_ComponentMask& set(const unsigned int _bit)
+	{
+		assert(_bit < NumberOfBits && "Trying to set a bit outside of the Component Mask.");
+		m_words[_bit >> 6] |= uint64_t{ 1 } << (_bit & 63);
+		return *this;
+	}
+	inline ECS_ComponentMask& reset(const unsigned int _bit)
+	{
+		assert(_bit < NumberOfBits && "Trying to reset a bit outside of the Component Mask.");
+		m_words[_bit >> 6] &= ~(uint64_t{ 1 } << (_bit & 63));
+		return *this;
+	}
+	inline ECS_ComponentMask& reset()
+	{
+		for (unsigned int i = 0; i < NumberOfWords; i++)
+		{
+			m_words[i] = 0;
+		}
+		return *this;
+	}
+
+	unsigned int count() const
+	{
+		unsigned int result = 0;
+		for (unsigned int i = 0; i < NumberOfWords; i++)
+		{
+			result += std::popcount(m_words[i]);
+		}
+		return result;
+	}
+
+	/// <summary>
+	/// Calls _function(bitIndex) for every set bit, in ascending order. Unset bits are skipped a whole word at a time.
+	/// </summary>
+	template<typename Function>
+	void ForEachSetBit(Function&& _function) const
+	{
+		for (unsigned int wordIndex = 0; wordIndex < NumberOfWords; wordIndex++)
+		{
+			uint64_t word = m_words[wordIndex];
+			while (word != 0)
+			{
+				_function(wordIndex * 64 + static_cast<unsigned int>(std::countr_zero(word)));
+				word &= word - 1; // Clearing the lowest set bit.
+			}
+		}
+	}
+
+#pragma endregion
+
+#pragma region Mask Queries
+
+	/// <summary>
+	/// Equivalent to "(*this & _other) == *this", without building the intermediate mask.
+	/// </summary>
+	bool IsSubsetOf(const ECS_ComponentMask& _other) const
+	{
+		if constexpr (NumberOfWords == 1)
+		{
+			return (m_words[0] & ~_other.m_words[0]) == 0;
+		}
+#if defined(ECS_COMPONENT_MASK_USE_AVX)
+		else if constexpr (NumberOfWords % 4 == 0)
+		{
+			for (unsigned int i = 0; i < NumberOfWords; i += 4)
+			{
+				// testc returns 1 when (~other & this) is all zeroes.
+				if (!_mm256_testc_si256(LoadAVX(_other.m_words + i), LoadAVX(m_words + i)))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+#endif
+#if defined(ECS_COMPONENT_MASK_USE_SSE41)
+		else if constexpr (NumberOfWords % 2 == 0)
+		{
+			for (unsigned int i = 0; i < NumberOfWords; i += 2)
+			{
+				if (!_mm_testc_si128(LoadSSE(_other.m_words + i), LoadSSE(m_words + i)))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+#elif defined(ECS_COMPONENT_MASK_USE_SSE2)
+		else if constexpr (NumberOfWords % 2 == 0)
+		{
+			__m128i missingBits = _mm_setzero_si128();
+			for (unsigned int i = 0; i < NumberOfWords; i += 2)
+			{
+				missingBits = _mm_or_si128(missingBits, _mm_andnot_si128(LoadSSE(_other.m_words + i), LoadSSE(m_words + i)));
+			}
+			return IsZeroSSE2(missingBits);
+		}
+#endif
+		else
+		{
+			uint64_t missingBits = 0;
+			for (unsigned int i = 0; i < NumberOfWords; i++)
+			{
+				missingBits |= m_words[i] & ~_other.m_words[i];
+			}
+			return missingBits == 0;
+		}
+	}
+
+	bool any() const
+	{
+		if constexpr (NumberOfWords == 1)
+		{
+			return m_words[0] != 0;
+		}
+#if defined(ECS_COMPONENT_MASK_USE_AVX)
+		else if constexpr (NumberOfWords % 4 == 0)
+		{
+			__m256i accumulated = LoadAVX(m_words);
+			for (unsigned int i = 4; i < NumberOfWords; i += 4)
+			{
+				accumulated = _mm256_or_si256(accumulated, LoadAVX(m_words + i));
+			}
+			return !_mm256_testz_si256(accumulated, accumulated);
+		}
+#endif
+#if defined(ECS_COMPONENT_MASK_USE_SSE41) || defined(ECS_COMPONENT_MASK_USE_SSE2)
+		else if constexpr (NumberOfWords % 2 == 0)
+		{
+			__m128i accumulated = LoadSSE(m_words);
+			for (unsigned int i = 2; i < NumberOfWords; i += 2)
+			{
+				accumulated = _mm_or_si128(accumulated, LoadSSE(m_words + i));
+			}
+#if defined(ECS_COMPONENT_MASK_USE_SSE41)
+			return !_mm_testz_si128(accumulated, accumulated);
+#else
+			return !IsZeroSSE2(accumulated);
+#endif
+		}
+#endif
+		else
+		{
+			uint64_t accumulated = 0;
+			for (unsigned int i = 0; i < NumberOfWords; i++)
+			{
+				accumulated |= m_words[i];
+			}
+			return accumulated != 0;
+		}
+	}
+	inline bool none() const { return !any(); };
+
+	/// <summary>
+	/// Returns true if both masks share at least one set bit. Equivalent to "(*this & _other).any()".
+	/// </summary>
+	inline bool Intersects(const ECS_ComponentMask& _other) const { return (*this & _other).any(); };
+
+#pragma endregion
+
+#pragma region Operators
+
+	ECS_ComponentMask operator&(const ECS_ComponentMask& _other) const
+	{
+		ECS_ComponentMask result;
+		for (unsigned int i = 0; i < NumberOfWords; i++)
+		{
+			result.m_words[i] = m_words[i] & _other.m_words[i];
+		}
+		return result;
+	}
+	ECS_ComponentMask operator|(const ECS_ComponentMask& _other) const
+	{
+		ECS_ComponentMask result;
+		for (unsigned int i = 0; i < NumberOfWords; i++)
+		{
+			result.m_words[i] = m_words[i] | _other.m_words[i];
+		}
+		return result;
+	}
+	ECS_ComponentMask& operator&=(const ECS_ComponentMask& _other)
+	{
+		for (unsigned int i = 0; i < NumberOfWords; i++)
+		{
+			m_words[i] &= _other.m_words[i];
+		}
+		return *this;
+	}
+	ECS_ComponentMask& operator|=(const ECS_ComponentMask& _other)
+	{
+		for (unsigned int i = 0; i < NumberOfWords; i++)
+		{
+			m_words[i] |= _other.m_words[i];
+		}
+		return *this;
+	}
+
+	bool operator==(const ECS_ComponentMask& _other) const
+	{
+		uint64_t differentBits = 0;
+		for (unsigned int i = 0; i < NumberOfWords; i++)
+		{
+			differentBits |= m_words[i] ^ _other.m_words[i];
+		}
+		return differentBits == 0;
+	}
+	inline bool operator!=(const ECS_ComponentMask& _other) const { return !(*this == _other); };
+
+#pragma endregion
+
+#pragma region INTERNAL
+
+private:
+#if defined(ECS_COMPONENT_MASK_USE_AVX)
+	static inline __m256i LoadAVX(const uint64_t* _words) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_words)); };
+#endif
+#if defined(ECS_COMPONENT_MASK_USE_SSE41) || defined(ECS_COMPONENT_MASK_USE_SSE2)
+	static inline __m128i LoadSSE(const uint64_t* _words) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(_words)); };
+#endif
+#if defined(ECS_COMPONENT_MASK_USE_SSE2)
+	static inline bool IsZeroSSE2(const __m128i _value) { return _mm_movemask_epi8(_mm_cmpeq_epi8(_value, _mm_setzero_si128())) == 0xFFFF; };
+#endif
+
+#pragma endregion
+};
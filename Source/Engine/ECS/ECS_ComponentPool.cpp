@@ -11,7 +11,9 @@ ECS_ComponentPool::ECS_ComponentPool(
 	delayed_copy_constructor_func _delayedCopyConstructorFunct,
 	delayed_funct_plus_one_object_param _delayedFunctWithOneObjectParam,
 	delayed_funct_serialize _delayedFunctSerialize,
-	delayed_funct_serialize _delayedFunctLoad)
+	delayed_funct_serialize _delayedFunctLoad,
+	delayed_funct_heap_memory _delayedFunctHeapMemory,
+	delayed_funct_build_render_command _delayedFunctBuildRenderCommand)
 	: m_uComponentSize{ _componentSize },
 	m_uNumberOfEntities{ _maxNumberOfEntities },
 	m_delayedUpdaterFunct{ _delayedUpdaterFunct },
@@ -20,7 +22,9 @@ ECS_ComponentPool::ECS_ComponentPool(
 	m_delayedCopyConstructorFunct{ _delayedCopyConstructorFunct },
 	m_delayedFunctWithOneObjectParam{ _delayedFunctWithOneObjectParam },
 	m_delayedFunctSerialize{ _delayedFunctSerialize },
-	m_delayedFunctLoad{ _delayedFunctLoad }
+	m_delayedFunctLoad{ _delayedFunctLoad },
+	m_delayedFunctHeapMemory{ _delayedFunctHeapMemory },
+	m_delayedFunctBuildRenderCommand{ _delayedFunctBuildRenderCommand }
 {
 	pData = new char[m_uComponentSize * m_uNumberOfEntities];
 }
@@ -54,6 +58,18 @@ int ECS_ComponentPool::CalculateElementIndex(const void* _pointer) const
 	return -1;
 }
 
+size_t ECS_ComponentPool::GetElementHeapMemoryUsage(unsigned int _index) const
+{
+	assert(_index < m_uNumberOfEntities && "Cannot obtain the heap memory of a Component at an index bigger than the number of entities of the Entity Pool.");
+
+	if (m_delayedFunctHeapMemory == nullptr)
+	{
+		return 0;
+	}
+
+	return m_delayedFunctHeapMemory(GetElement(_index));
+}
+
 void ECS_ComponentPool::UpdateElement(unsigned int _index, float _deltaTime)
 {
 	assert(_index < m_uNumberOfEntities && "Cannot create a Update a Component at a bigger index than the number of entities of the Entity Pool.");
@@ -247,6 +263,15 @@ void ECS_ComponentPool::CallStoredFunctionWithObjectParam(EntityID* _arrayOfEnti
 	}
 }
 
+bool ECS_ComponentPool::BuildElementRenderCommand(unsigned int _index, const void* _transform, RenderCommand* _command) const
+{
+	assert(_index < m_uNumberOfEntities && "Cannot build the Render Command of a Component at an index bigger than the number of entities of the Entity Pool.");
+	assert(_transform != nullptr && "Trying to build the Render Command of an element but the pointer to the Transform was nullptr.");
+	assert(m_delayedFunctBuildRenderCommand != nullptr && "Trying to build the Render Command of an element but the pointer to the function was nullptr.");
+
+	return m_delayedFunctBuildRenderCommand(GetElement(_index), _transform, _command);
+}
+
 bool ECS_ComponentPool::SerializeElement(unsigned int _index, pugi::xml_node* _ComponentNode)
 {
 	assert(_index < m_uNumberOfEntities && "Cannot Serialize a Component at an index bigger than the number of entities of the Entity Pool.");
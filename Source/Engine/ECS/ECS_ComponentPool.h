@@ -20,6 +20,8 @@ public:
 	delayed_funct_plus_one_object_param m_delayedFunctWithOneObjectParam;
 	delayed_funct_serialize m_delayedFunctSerialize;
 	delayed_funct_serialize m_delayedFunctLoad;
+	delayed_funct_heap_memory m_delayedFunctHeapMemory;
+	delayed_funct_build_render_command m_delayedFunctBuildRenderCommand;
 
 	// Constructors & Destructors
 	ECS_ComponentPool(
@@ -31,7 +33,9 @@ public:
 		delayed_copy_constructor_func _delayedCopyConstructorFunct,
 		delayed_funct_plus_one_object_param _delayedFunctWithOneObjectParam,
 		delayed_funct_serialize _delayedFunctSerialize,
-		delayed_funct_serialize _delayedFunctLoad);
+		delayed_funct_serialize _delayedFunctLoad,
+		delayed_funct_heap_memory _delayedFunctHeapMemory,
+		delayed_funct_build_render_command _delayedFunctBuildRenderCommand);
 	~ECS_ComponentPool();
 
 	// Public Methods
@@ -39,6 +43,10 @@ public:
 	void* GetElement(EntityID _entityId) const;
 	int CalculateElementIndex(const void* _pointer) const;
 
+	inline size_t GetReservedMemory() const { return static_cast<size_t>(m_uComponentSize) * m_uNumberOfEntities; };
+	inline bool TracksHeapMemory() const { return m_delayedFunctHeapMemory != nullptr; };
+	size_t GetElementHeapMemoryUsage(unsigned int _index) const;
+
 	void UpdateElement(unsigned int _index, float _deltaTime);
 	void UpdateElement(EntityID _entityId, float _deltaTime);
 	void UpdateElements(unsigned int* _arrayOfIndex, unsigned int _arrayLength, float _deltaTime);
@@ -64,6 +72,8 @@ public:
 	void CallStoredFunctionWithObjectParam(unsigned int* _arrayOfIndex, unsigned int _arrayLength, void* _object);
 	void CallStoredFunctionWithObjectParam(EntityID* _arrayOfEntityIds, unsigned int _arrayLength, void* _object);
 
+	bool BuildElementRenderCommand(unsigned int _index, const void* _transform, RenderCommand* _command) const;
+
 	bool SerializeElement(unsigned int _index, pugi::xml_node* _ComponentNode);
 	bool SerializeElement(EntityID _entityId, pugi::xml_node* _ComponentNode);
 
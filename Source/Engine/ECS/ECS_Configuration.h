@@ -1,4 +1,21 @@
 #pragma once
 
+// Both values are the width of a component mask (see ECS_ComponentMask.h), so they can only be 32, 64, 128, 256 or 512.
+// MAX_NUMBER_OF_COMPONENTS_INSIDE_ENTITY_POOL can't be bigger than MAX_TOTAL_NUMBER_OF_COMPONENTS.
 static constexpr int MAX_TOTAL_NUMBER_OF_COMPONENTS = 64;
 static constexpr int MAX_NUMBER_OF_COMPONENTS_INSIDE_ENTITY_POOL = 32;
+
+// Default number of Entity slots handled by each Job of ECS_PoolManager::ParallelForEach.
+static constexpr unsigned int PARALLEL_FOR_EACH_GRAIN_SIZE = 256;
+
+// Pool capacity tuning.
+// When recording, the Engine tracks the high-water mark and spawn rate of every Entity Pool during the session,
+// and writes a RecommendedCapacity for each of them into ECS_Pools_Information.xml when it quits.
+static constexpr bool RECORD_POOL_CAPACITIES = false;
+// When true, CreateEntityPool uses the RecommendedCapacity stored in ECS_Pools_Information.xml instead of the hardcoded capacity.
+static constexpr bool USE_RECOMMENDED_POOL_CAPACITIES = true;
+// Smallest part of its hardcoded capacity a Pool can shrink to with a RecommendedCapacity (0.25f means a quarter),
+// so a short recording session can't leave it too small for a longer one. 1.0f only lets Pools grow.
+static constexpr float MIN_RECOMMENDED_POOL_CAPACITY_RATIO = 0.25f;
+// Extra room added on top of the recorded high-water mark (0.25f means 25% more Entities than ever used at once).
+static constexpr float RECOMMENDED_POOL_CAPACITY_HEADROOM = 0.25f;
@@ -8,8 +8,8 @@ namespace ECS
   {
     static consteval ComponentIndex InvalidComponentIndex()
     {
-      static_assert(255 > MAX_TOTAL_NUMBER_OF_COMPONENTS, "You gotta change the type of ComponentIds to something bigger.");
-      return 255u;
+      static_assert(static_cast<ComponentIndex>(-1) > MAX_TOTAL_NUMBER_OF_COMPONENTS, "You gotta change the type of ComponentIds to something bigger.");
+      return static_cast<ComponentIndex>(-1);
     }
     static consteval unsigned int InvalidEntityIndex() { return 16581375u; }
     static consteval unsigned int InvalidEntityVersion() { return 268435455u; }
@@ -31,6 +31,10 @@ ECS_EntityPool::ECS_EntityPool(ECS_PoolManager* _pPoolManager,
 
 	// Creating the references to our T Pools.
 	m_componentPools.resize(MAX_NUMBER_OF_COMPONENTS_INSIDE_ENTITY_POOL, nullptr); // Setting the initial value to nullptr just in case.
+
+	// Every slot exists from the start (as a deleted Entity), so creating Entities never reallocates.
+	m_entities.resize(m_uMaxNumberOfEntities, ECS_Entity(ECS::CreateEntityId(ECS::CONSTANTS::InvalidEntityIndex(), m_poolId, 0), EntityComponentMask()));
+	m_freeEntitiesNext.resize(m_uMaxNumberOfEntities, ECS::CONSTANTS::InvalidEntityID());
 };
 
 ECS_EntityPool::~ECS_EntityPool()
@@ -48,50 +52,42 @@ ECS_EntityPool::~ECS_EntityPool()
 
 EntityID ECS_EntityPool::CreateEntity()
 {
-	assert(m_entities.size() < m_uMaxNumberOfEntities && "Trying to create more Entities than the MAX_NUMBER_OF_ENTITIES for this specific Entity pool.");
+	EntityID newEntityId = PopFreeEntity();
 
-	if (!m_freeEntities.empty())
+	if (newEntityId == ECS::CONSTANTS::InvalidEntityID())
 	{
-		unsigned int index = m_freeEntities.back();
-		m_freeEntities.pop_back();
+		// Bump-allocating a slot that has never been used.
+		std::atomic_ref<unsigned int> highWaterMark(m_uHighWaterMark);
+		unsigned int newIndex = highWaterMark.load(std::memory_order_relaxed);
+		do
+		{
+			if (newIndex >= m_uMaxNumberOfEntities)
+			{
+				assert(false && "Trying to create more Entities than the MAX_NUMBER_OF_ENTITIES for this specific Entity pool.");
+				return ECS::CONSTANTS::InvalidEntityID();
+			}
+		} while (!highWaterMark.compare_exchange_weak(newIndex, newIndex + 1, std::memory_order_relaxed));
 
-		return m_entities[index].SetIndex(index); // SetIndex returns the new ID.
+		newEntityId = ECS::CreateEntityId(newIndex, m_poolId, 0);
 	}
 
-	m_entities.push_back(ECS_Entity(ECS::CreateEntityId(m_entities.size(), m_poolId, 0), EntityComponentMask()));
-	return m_entities.back().m_id;
+	std::atomic_ref<unsigned int>(m_uTotalCreatedEntities).fetch_add(1, std::memory_order_relaxed);
+
+	// Only the creating thread knows about this slot until the ID is returned.
+	m_entities[ECS::GetIndexFromId(newEntityId)].m_id = newEntityId;
+	return newEntityId;
 }
 unsigned int ECS_EntityPool::CreateEntities(unsigned int _numberOfEntitiesToCreate, EntityID* _entitiesIdBuffer)
 {
-	if (_numberOfEntitiesToCreate == 0)
-	{
-		return 0;
-	}
-
-	unsigned int currentSizeOfEntityVector = m_entities.size();
-	unsigned int numberOfFreeEntities = m_freeEntities.size();
-
-	if (m_uMaxNumberOfEntities < (_numberOfEntitiesToCreate + currentSizeOfEntityVector - numberOfFreeEntities))
-	{
-		assert(false && "Trying to create more Entities than the MAX_NUMBER_OF_ENTITIES for this specific Entity pool.");
-
-		// We correct how many entities we create. This is not ideal, but if handled correctly by the user of the function 
-		// (and if asserts are disabled), it should avoid throwing an error.
-		_numberOfEntitiesToCreate = m_uMaxNumberOfEntities - currentSizeOfEntityVector + numberOfFreeEntities;
-	}
-
+	// When the Pool gets full, CreateEntity asserts and we return how many Entities were created. This is not ideal, but if handled
+	// correctly by the user of the function (and if asserts are disabled), it should avoid throwing an error.
 	for (unsigned int i = 0; i < _numberOfEntitiesToCreate; i++)
 	{
-		if (numberOfFreeEntities == 0)
-		{
-			m_entities.push_back(ECS_Entity(ECS::CreateEntityId(currentSizeOfEntityVector++, m_poolId, 0), EntityComponentMask()));
-			_entitiesIdBuffer[i] = m_entities.back().m_id;
-		}
-		else
+		_entitiesIdBuffer[i] = CreateEntity();
+
+		if (_entitiesIdBuffer[i] == ECS::CONSTANTS::InvalidEntityID())
 		{
-			_entitiesIdBuffer[i] = m_entities[m_freeEntities.back()].SetIndex(m_freeEntities.back());
-			m_freeEntities.pop_back();
-			numberOfFreeEntities--;
+			return i;
 		}
 	}
 
@@ -138,7 +134,7 @@ void ECS_EntityPool::DestroyEntity(EntityID _entityId)
 
 	m_entities[entityIndex].m_id = ECS::CreateEntityId(ECS::CONSTANTS::InvalidEntityIndex(), m_poolId, entityVersion + 1);
 
-	m_freeEntities.push_back(entityIndex);
+	PushFreeEntity(ECS::CreateEntityId(entityIndex, m_poolId, entityVersion + 1));
 }
 void ECS_EntityPool::DestroyEntity(unsigned int _entityIndex)
 {
@@ -171,7 +167,7 @@ void ECS_EntityPool::DestroyEntity(unsigned int _entityIndex)
 
 	m_entities[_entityIndex].m_id = ECS::CreateEntityId(ECS::CONSTANTS::InvalidEntityIndex(), m_poolId, _entityVersion + 1);
 
-	m_freeEntities.push_back(_entityIndex);
+	PushFreeEntity(ECS::CreateEntityId(_entityIndex, m_poolId, _entityVersion + 1));
 }
 
 void ECS_EntityPool::DestroyEntities(EntityID* _entityIdBuffer, unsigned int _lengthOfBuffer)
@@ -205,6 +201,40 @@ void ECS_EntityPool::DestroyAllEntities()
 	}
 }
 
+EntityID ECS_EntityPool::PopFreeEntity()
+{
+	std::atomic_ref<EntityID> head(m_freeEntitiesHead);
+	EntityID currentHead = head.load(std::memory_order_acquire);
+
+	while (currentHead != ECS::CONSTANTS::InvalidEntityID())
+	{
+		// If another thread pops this slot first, the head changes; if it also pushes it back, the version does. Either way the exchange fails.
+		const EntityID nextHead = std::atomic_ref<EntityID>(m_freeEntitiesNext[ECS::GetIndexFromId(currentHead)]).load(std::memory_order_relaxed);
+
+		if (head.compare_exchange_weak(currentHead, nextHead, std::memory_order_acquire, std::memory_order_acquire))
+		{
+			std::atomic_ref<unsigned int>(m_uNumberOfFreeEntities).fetch_sub(1, std::memory_order_relaxed);
+			return currentHead;
+		}
+	}
+
+	return ECS::CONSTANTS::InvalidEntityID();
+}
+void ECS_EntityPool::PushFreeEntity(EntityID _nextEntityId)
+{
+	std::atomic_ref<EntityID> head(m_freeEntitiesHead);
+	std::atomic_ref<EntityID> next(m_freeEntitiesNext[ECS::GetIndexFromId(_nextEntityId)]);
+	EntityID currentHead = head.load(std::memory_order_relaxed);
+
+	// Releasing, so the thread that pops the slot sees it fully destroyed.
+	do
+	{
+		next.store(currentHead, std::memory_order_relaxed);
+	} while (!head.compare_exchange_weak(currentHead, _nextEntityId, std::memory_order_release, std::memory_order_relaxed));
+
+	std::atomic_ref<unsigned int>(m_uNumberOfFreeEntities).fetch_add(1, std::memory_order_relaxed);
+}
+
 #pragma endregion
 
 #pragma region T Management
@@ -438,14 +468,11 @@ EntityComponentMask ECS_EntityPool::ConvertPoolMaskToEntityMask(const PoolCompon
 {
 	EntityComponentMask resultMask;
 
-	for (unsigned int i = 0; i < MAX_TOTAL_NUMBER_OF_COMPONENTS; i++)
-	{
-		if (_poolMask.test(i))
+	_poolMask.ForEachSetBit([this, &resultMask](const unsigned int _componentId)
 		{
-			assert(GetComponentIndex(i) != ECS::CONSTANTS::InvalidComponentIndex() && "Converting a Pool Component Mask into an Entity Component Mask but the Pool Mask contained Component Ids that have not been initialized in this Entity Pool.");
-			resultMask.set(GetComponentIndex(i));
-		}
-	}
+			assert(GetComponentIndex(_componentId) != ECS::CONSTANTS::InvalidComponentIndex() && "Converting a Pool Component Mask into an Entity Component Mask but the Pool Mask contained Component Ids that have not been initialized in this Entity Pool.");
+			resultMask.set(GetComponentIndex(_componentId));
+		});
 
 	return resultMask;
 }
@@ -514,11 +541,11 @@ EntityID ECS_EntityPool::PoolIterator::operator*() const
 }
 bool ECS_EntityPool::PoolIterator::operator==(const PoolIterator& other) const
 {																													 // The last part here checks if we are at the end of the iterator, which behaves differently when compared.
-	return m_uCurrentEntityIndex == other.m_uCurrentEntityIndex || m_uCurrentEntityIndex == m_pEntityPool->m_entities.size();
+	return m_uCurrentEntityIndex == other.m_uCurrentEntityIndex || m_uCurrentEntityIndex == m_pEntityPool->GetHighWaterMark();
 }
 bool ECS_EntityPool::PoolIterator::operator!=(const PoolIterator& other) const
 {
-	return m_uCurrentEntityIndex != other.m_uCurrentEntityIndex && m_uCurrentEntityIndex != m_pEntityPool->m_entities.size();
+	return m_uCurrentEntityIndex != other.m_uCurrentEntityIndex && m_uCurrentEntityIndex != m_pEntityPool->GetHighWaterMark();
 }
 
 ECS_EntityPool::PoolIterator& ECS_EntityPool::PoolIterator::operator++()
@@ -527,7 +554,7 @@ ECS_EntityPool::PoolIterator& ECS_EntityPool::PoolIterator::operator++()
 	{
 		m_uCurrentEntityIndex++;
 	}
-	while (m_uCurrentEntityIndex < m_pEntityPool->m_entities.size() && !IsCurrentIndexValidForIterator());
+	while (m_uCurrentEntityIndex < m_pEntityPool->GetHighWaterMark() && !IsCurrentIndexValidForIterator());
 
 	return *this;
 }
@@ -552,7 +579,7 @@ bool ECS_EntityPool::PoolIterator::IsCurrentIndexValidForIterator() const
 		}
 		else
 		{
-			return m_componentMask == (m_componentMask & m_pEntityPool->m_entities[m_uCurrentEntityIndex].m_componentMask);
+			return m_componentMask.IsSubsetOf(m_pEntityPool->m_entities[m_uCurrentEntityIndex].m_componentMask);
 		}
 	}
 
@@ -565,7 +592,7 @@ ECS_EntityPool::PoolIterator ECS_EntityPool::BeginIterator(const PoolComponentMa
 	EntityComponentMask mask;
 	if (_emptyMask)
 	{
-		while (firstIndex < m_entities.size() && IsEntityDeleted(firstIndex))
+		while (firstIndex < GetHighWaterMark() && IsEntityDeleted(firstIndex))
 		{
 			firstIndex++;
 		}
@@ -574,8 +601,8 @@ ECS_EntityPool::PoolIterator ECS_EntityPool::BeginIterator(const PoolComponentMa
 	{
 		mask = ConvertPoolMaskToEntityMask(_poolMask);
 
-		while (firstIndex < m_entities.size() &&
-			(mask != (mask & m_entities[firstIndex].m_componentMask) || IsEntityDeleted(firstIndex))
+		while (firstIndex < GetHighWaterMark() &&
+			(!mask.IsSubsetOf(m_entities[firstIndex].m_componentMask) || IsEntityDeleted(firstIndex))
 			)
 		{
 			firstIndex++;
@@ -588,7 +615,7 @@ ECS_EntityPool::PoolIterator ECS_EntityPool::BeginIterator(const PoolComponentMa
 ECS_EntityPool::PoolIterator ECS_EntityPool::EndIterator(const PoolComponentMask& _poolMask, bool _emptyMask)
 {
 	{
-		unsigned int lastIndex = m_entities.size();
+		unsigned int lastIndex = GetHighWaterMark();
 
 		EntityComponentMask mask;
 
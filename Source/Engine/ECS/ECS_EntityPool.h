@@ -8,6 +8,7 @@
 #include "ECS_Entity.h"
 #include "assert.h"
 #include <array>
+#include <atomic>
 #include <vector>
 
 class ECS_PoolManager;
@@ -21,10 +22,22 @@ class ECS_EntityPool
 	const PoolID m_poolId;
 	const ECS_PoolManager* m_pPoolManager;
 
-	std::vector<unsigned int> m_freeEntities;
+	// Entity creation and destruction are lock-free, so they can happen from several Jobs at the same time.
+	// The shared counters are plain values accessed through std::atomic_ref, which keeps the Pool copyable inside the PoolManager's vector.
+
+	// Lock-free stack of free Entity slots. The head is the EntityID that the next reused slot will get: its version bits change every time
+	// the slot is destroyed, so a slot that was popped and pushed again is never mistaken for the old head (ABA).
+	alignas(std::atomic_ref<EntityID>::required_alignment) EntityID m_freeEntitiesHead{ ECS::CONSTANTS::InvalidEntityID() };
+	std::vector<EntityID> m_freeEntitiesNext; // For every free slot, the next element of the stack.
+	alignas(std::atomic_ref<unsigned int>::required_alignment) unsigned int m_uNumberOfFreeEntities{ 0 };
+
+	// Slots below it have been used at least once. New slots are bump-allocated from it.
+	alignas(std::atomic_ref<unsigned int>::required_alignment) unsigned int m_uHighWaterMark{ 0 };
+
+	alignas(std::atomic_ref<unsigned int>::required_alignment) unsigned int m_uTotalCreatedEntities{ 0 }; // Every Entity ever created in this Pool, used to measure spawn rates.
 
 public:
-	std::vector<ECS_Entity> m_entities;
+	std::vector<ECS_Entity> m_entities; // Pre-allocated for the maximum number of Entities, so it never moves while Entities are created.
 	std::vector<ECS_ComponentPool*> m_componentPools;
 
 #pragma region Constructors & Destructor
@@ -84,10 +97,27 @@ public:
 
 	inline int GetComponentPoolsCount() const { return m_uNumberOfInitializedComponents; };
 
+	inline unsigned int GetMaxNumberOfEntities() const { return m_uMaxNumberOfEntities; };
+	// These counters are not synchronized with Entities being created at the same time in other threads.
+	inline unsigned int GetNumberOfLiveEntities() const { return m_uHighWaterMark - m_uNumberOfFreeEntities; };
+	/// <summary>
+	/// Highest number of Entity slots that have ever been in use at the same time. Slots are never released, so no Entity lives above it.
+	/// </summary>
+	inline unsigned int GetHighWaterMark() const { return m_uHighWaterMark; };
+	inline unsigned int GetFreeListLength() const { return m_uNumberOfFreeEntities; };
+	inline unsigned int GetTotalCreatedEntities() const { return m_uTotalCreatedEntities; };
+	inline size_t GetBookkeepingMemoryUsage() const
+		{ return m_entities.capacity() * sizeof(ECS_Entity) + m_freeEntitiesNext.capacity() * sizeof(EntityID) + m_componentPools.capacity() * sizeof(ECS_ComponentPool*); };
+
 #pragma endregion
 
 #pragma region Entity Management
 
+	/// <summary>
+	/// Lock-free: it can be called from several threads at the same time, together with DestroyEntity and with the Component assignment
+	/// of the returned Entity. It must not run at the same time as an iteration over this Pool.
+	/// Returns an invalid EntityID when the Pool is full.
+	/// </summary>
 	EntityID CreateEntity();
 
 	/// <summary>
@@ -103,10 +133,13 @@ public:
 	template<typename... Components>
 	EntityID CreateEntityWithComponents()
 	{
-		assert(m_entities.size() < m_uMaxNumberOfEntities && "Trying to create more Entities than the MAX_NUMBER_OF_ENTITIES for this specific Entity pool.");
-
 		EntityID id = CreateEntity();
 
+		if (id == ECS::CONSTANTS::InvalidEntityID())
+		{
+			return id;
+		}
+
 		AssignComponents<Components...>(id);
 
 		return id;
@@ -124,6 +157,16 @@ public:
 
 	void DestroyAllEntities();
 
+private:
+	/// <summary>
+	/// Pops a slot from the free stack and returns the EntityID it gets, or an invalid EntityID if the stack is empty.
+	/// </summary>
+	EntityID PopFreeEntity();
+	/// <summary>
+	/// Pushes the slot of the given EntityID, which is the ID it will get when reused.
+	/// </summary>
+	void PushFreeEntity(EntityID _nextEntityId);
+
 #pragma endregion
 
 #pragma region Component Management
@@ -205,6 +248,11 @@ public:
 	}
 	bool HasComponentEnabled(EntityID _entityId, unsigned int _componentIndex) const;
 	bool HasComponentEnabled(unsigned int _entityIndex, unsigned int _componentIndex) const;
+	/// <summary>
+	/// Returns true if the Entity at the given index exists and has every Component of the mask enabled.
+	/// </summary>
+	inline bool HasComponentsEnabled(unsigned int _entityIndex, const EntityComponentMask& _entityMask) const
+		{ return !IsEntityDeleted(_entityIndex) && _entityMask.IsSubsetOf(m_entities[_entityIndex].m_componentMask); };
 
 	template<typename T>
 	T* GetComponent(EntityID _entityId)
@@ -675,8 +723,21 @@ private:
 				delayedFunctLoad = &ECS_INTERNAL::DelayedFunctionLoad<FirstComponent>;
 			}
 
+			delayed_funct_heap_memory delayedFunctHeapMemory{ nullptr };
+			if constexpr (ECS_INTERNAL::Implements_IECS_HeapMemory<FirstComponent>())
+			{
+				delayedFunctHeapMemory = &ECS_INTERNAL::DelayedFunctionHeapMemory<FirstComponent>;
+			}
+
+			delayed_funct_build_render_command delayedFunctBuildRenderCommand{ nullptr };
+			if constexpr (ECS_INTERNAL::Implements_IECS_Render<FirstComponent>())
+			{
+				delayedFunctBuildRenderCommand = &ECS_INTERNAL::DelayedFunctionBuildRenderCommand<FirstComponent>;
+			}
+
 			m_componentPools[GetComponentIndex<FirstComponent>()] = new ECS_ComponentPool(sizeof(FirstComponent), m_uMaxNumberOfEntities,
-				delayedUpdaterFunct, delayedConstructorFunct, delayedDeleterFunct, delayedCopyConstructorFunct, delayedFunctWithOneObjectParam, delayedFunctSerialize, delayedFunctLoad);
+				delayedUpdaterFunct, delayedConstructorFunct, delayedDeleterFunct, delayedCopyConstructorFunct, delayedFunctWithOneObjectParam, delayedFunctSerialize, delayedFunctLoad,
+				delayedFunctHeapMemory, delayedFunctBuildRenderCommand);
 		}
 
 		// Initializing the next T.
@@ -949,7 +1010,7 @@ public:
 				return nullptr;
 			}
 
-			if (m_uCurrentEntityIndex >= m_pEntityPool->m_entities.size())
+			if (m_uCurrentEntityIndex >= m_pEntityPool->GetHighWaterMark())
 			{
 				assert(false && "Trying to Get a component from a PoolIterator with an invalid entity Index.");
 
@@ -981,8 +1042,8 @@ public:
 			mask = ConvertPoolMaskToEntityMask<IteratorTypes...>();
 		}
 
-		while (firstIndex < m_entities.size() &&
-			(mask != (mask & m_entities[firstIndex].m_componentMask) || IsEntityDeleted(firstIndex))
+		while (firstIndex < GetHighWaterMark() &&
+			(!mask.IsSubsetOf(m_entities[firstIndex].m_componentMask) || IsEntityDeleted(firstIndex))
 			)
 		{
 			firstIndex++;
@@ -995,7 +1056,7 @@ public:
 	template<typename... IteratorTypes>
 	PoolIterator EndIterator()
 	{
-		unsigned int lastIndex = m_entities.size();
+		unsigned int lastIndex = GetHighWaterMark();
 
 		EntityComponentMask mask;
 
@@ -1,7 +1,10 @@
 #pragma once
 
 class IECS_Update {};
+class IECS_ThreadSafeUpdate {}; // Marks an IECS_Update Component whose Update only touches its own data, so UpdateComponents can run it on worker threads.
 class IECS_CopyConstructor {};
-class IECS_Render {};
+class IECS_Render {}; // Components implementing it must define "void Render(const C_Transform2D*) const" and "bool BuildRenderCommand(const C_Transform2D*, RenderCommand&) const".
 class IECS_Transform {};
-class IECS_Serializable {};
\ No newline at end of file
+class IECS_Serializable {};
+class IECS_HeapMemory {}; // Components implementing it must define "size_t GetHeapMemoryUsage() const".
+class IECS_System {}; // Systems implementing it must define "void Update(ECS_PoolManager*, float)" and the "Reads" and "Writes" ECS_ComponentList types.
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "ECS_MemoryReport.h"
+#include "Engine/Util/XML/XML_File_Handler.h"
+
+#pragma region Pool Report
+
+size_t ECS_PoolMemoryReport::GetReservedBytes() const
+{
+	size_t result = m_bookkeepingBytes;
+	for (const ECS_ComponentMemoryReport& component : m_components)
+	{
+		result += component.m_reservedBytes;
+	}
+
+	return result;
+}
+size_t ECS_PoolMemoryReport::GetLiveBytes() const
+{
+	size_t result = 0;
+	for (const ECS_ComponentMemoryReport& component : m_components)
+	{
+		result += component.m_liveBytes;
+	}
+
+	return result;
+}
+size_t ECS_PoolMemoryReport::GetHeapBytes() const
+{
+	size_t result = 0;
+	for (const ECS_ComponentMemoryReport& component : m_components)
+	{
+		result += component.m_heapBytes;
+	}
+
+	return result;
+}
+
+#pragma endregion
+
+#pragma region Memory Report
+
+size_t ECS_MemoryReport::GetReservedBytes() const
+{
+	size_t result = 0;
+	for (const ECS_PoolMemoryReport& pool : m_pools)
+	{
+		result += pool.GetReservedBytes();
+	}
+
+	return result;
+}
+size_t ECS_MemoryReport::GetLiveBytes() const
+{
+	size_t result = 0;
+	for (const ECS_PoolMemoryReport& pool : m_pools)
+	{
+		result += pool.GetLiveBytes();
+	}
+
+	return result;
+}
+size_t ECS_MemoryReport::GetHeapBytes() const
+{
+	size_t result = 0;
+	for (const ECS_PoolMemoryReport& pool : m_pools)
+	{
+		result += pool.GetHeapBytes();
+	}
+
+	return result;
+}
+
+bool ECS_MemoryReport::Serialize(pugi::xml_node* _ReportNode) const
+{
+	if (_ReportNode == nullptr || _ReportNode->empty())
+	{
+		return false;
+	}
+
+	_ReportNode->append_attribute("ReservedBytes").set_value(std::to_string(GetReservedBytes()).c_str());
+	_ReportNode->append_attribute("LiveBytes").set_value(std::to_string(GetLiveBytes()).c_str());
+	_ReportNode->append_attribute("HeapBytes").set_value(std::to_string(GetHeapBytes()).c_str());
+
+	for (const ECS_PoolMemoryReport& pool : m_pools)
+	{
+		pugi::xml_node poolNode = _ReportNode->append_child("EntityPool");
+		poolNode.append_attribute("PoolName").set_value(pool.m_poolName.c_str());
+		poolNode.append_attribute("PoolID").set_value(std::to_string(pool.m_poolId).c_str());
+		poolNode.append_attribute("Capacity").set_value(std::to_string(pool.m_uCapacity).c_str());
+		poolNode.append_attribute("LiveEntities").set_value(std::to_string(pool.m_uLiveEntities).c_str());
+		poolNode.append_attribute("HighWaterMark").set_value(std::to_string(pool.m_uHighWaterMark).c_str());
+		poolNode.append_attribute("FreeListLength").set_value(std::to_string(pool.m_uFreeListLength).c_str());
+		poolNode.append_attribute("BookkeepingBytes").set_value(std::to_string(pool.m_bookkeepingBytes).c_str());
+		poolNode.append_attribute("ReservedBytes").set_value(std::to_string(pool.GetReservedBytes()).c_str());
+		poolNode.append_attribute("LiveBytes").set_value(std::to_string(pool.GetLiveBytes()).c_str());
+		poolNode.append_attribute("HeapBytes").set_value(std::to_string(pool.GetHeapBytes()).c_str());
+
+		for (const ECS_ComponentMemoryReport& component : pool.m_components)
+		{
+			pugi::xml_node componentNode = poolNode.append_child("ECS_Component");
+			componentNode.append_attribute("ComponentName").set_value(component.m_componentName.c_str());
+			componentNode.append_attribute("ComponentIndex").set_value(std::to_string(component.m_componentIndex).c_str());
+			componentNode.append_attribute("ComponentSize").set_value(std::to_string(component.m_uComponentSize).c_str());
+			componentNode.append_attribute("LiveComponents").set_value(std::to_string(component.m_uLiveComponents).c_str());
+			componentNode.append_attribute("ReservedBytes").set_value(std::to_string(component.m_reservedBytes).c_str());
+			componentNode.append_attribute("LiveBytes").set_value(std::to_string(component.m_liveBytes).c_str());
+			componentNode.append_attribute("Occupancy").set_value(std::to_string(component.GetOccupancy()).c_str());
+
+			if (component.m_tracksHeapMemory)
+			{
+				componentNode.append_attribute("HeapBytes").set_value(std::to_string(component.m_heapBytes).c_str());
+			}
+		}
+	}
+
+	return true;
+}
+
+bool ECS_MemoryReport::SaveToFile(const std::string& _FilePath) const
+{
+	pugi::xml_document reportDocument;
+	pugi::xml_node reportNode = reportDocument.append_child("ECS_MemoryReport");
+
+	if (!Serialize(&reportNode))
+	{
+		return false;
+	}
+
+	return XML_UTIL::SaveXMLFile(_FilePath, reportDocument);
+}
+
+#pragma endregion
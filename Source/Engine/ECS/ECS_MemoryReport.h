@@ -0,0 +1,56 @@
+#pragma once
+
+#include "ECS_Typedefs.h"
+#include "Engine/ExternalLibraries/Pugixml/pugixml.hpp"
+#include <string>
+#include <vector>
+
+struct ECS_ComponentMemoryReport
+{
+	std::string m_componentName;
+	ComponentIndex m_componentIndex{ 0 };
+	unsigned int m_uComponentSize{ 0 };
+	unsigned int m_uLiveComponents{ 0 };
+
+	size_t m_reservedBytes{ 0 }; // Size of the Component times the capacity of its Entity Pool.
+	size_t m_liveBytes{ 0 }; // Size of the Component times the number of Entities that have it enabled.
+	size_t m_heapBytes{ 0 }; // Only counted for Components that implement IECS_HeapMemory.
+	bool m_tracksHeapMemory{ false };
+
+	inline float GetOccupancy() const { return m_reservedBytes == 0 ? 0.0f : static_cast<float>(m_liveBytes) / m_reservedBytes; };
+};
+
+struct ECS_PoolMemoryReport
+{
+	std::string m_poolName;
+	PoolID m_poolId{ 0 };
+
+	unsigned int m_uCapacity{ 0 };
+	unsigned int m_uLiveEntities{ 0 };
+	unsigned int m_uHighWaterMark{ 0 };
+	unsigned int m_uFreeListLength{ 0 };
+
+	size_t m_bookkeepingBytes{ 0 }; // Entity vector, free list and Component Pool pointers.
+
+	std::vector<ECS_ComponentMemoryReport> m_components;
+
+	size_t GetReservedBytes() const;
+	size_t GetLiveBytes() const;
+	size_t GetHeapBytes() const;
+};
+
+/// <summary>
+/// Snapshot of how much memory every Entity Pool reserves against how much of it is actually in use.
+/// Obtained through ECS_PoolManager::GetMemoryReport().
+/// </summary>
+struct ECS_MemoryReport
+{
+	std::vector<ECS_PoolMemoryReport> m_pools;
+
+	size_t GetReservedBytes() const;
+	size_t GetLiveBytes() const;
+	size_t GetHeapBytes() const;
+
+	bool Serialize(pugi::xml_node* _ReportNode) const;
+	bool SaveToFile(const std::string& _FilePath) const;
+};
@@ -1,5 +1,12 @@
 #include "ECS_PoolManager.h"
 #include "ECS_SupportingFunctions.h"
+#include "Engine/Engine.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
 
 ECS_PoolManager::ECS_PoolManager()
 {
@@ -14,6 +21,9 @@ ECS_PoolManager* ECS_PoolManager::InitManager()
 {
 	Instance = new ECS_PoolManager();
 
+	// The previous file is only read to find recommended capacities. A missing file simply means that there are no recommendations yet.
+	XML_UTIL::ReadXMLFile(GetPoolInfoFilePath(), Instance->PreviousPoolInfoDocument);
+
 	Instance->PoolInfoDocument.append_child("PoolList");
 
 	return Instance;
@@ -61,6 +71,23 @@ void ECS_PoolManager::UpdateComponents(float _deltaTime)
 			PoolComponentMask mask;
 			mask.set(i);
 
+			// Components that only touch their own data are updated from the worker threads.
+			if (m_IThreadSafeUpdateComponentIds.test(i))
+			{
+				ParallelForEachRange(mask, [i, _deltaTime](ECS_EntityPool& _EntityPool, unsigned int _uBegin, unsigned int _uEnd, const EntityComponentMask& _entityMask)
+					{
+						ECS_ComponentPool* componentPool = _EntityPool.GetComponentPool(i);
+						for (unsigned int entityIndex = _uBegin; entityIndex < _uEnd; entityIndex++)
+						{
+							if (_EntityPool.HasComponentsEnabled(entityIndex, _entityMask))
+							{
+								componentPool->UpdateElement(entityIndex, _deltaTime);
+							}
+						}
+					});
+				continue;
+			}
+
 			Iterator end = EndIterator(mask);
 			for (Iterator it = BeginIterator(mask); it != end; ++it)
 			{
@@ -79,8 +106,18 @@ void ECS_PoolManager::UpdateComponents(float _deltaTime)
 
 void ECS_PoolManager::RenderEntities()
 {
+	BuildRenderQueue(m_renderQueue);
+	m_renderQueue.Submit(Engine::GetInstance()->GetTigrScreen());
+}
+
+void ECS_PoolManager::BuildRenderQueue(RenderQueue& _RenderQueue, float _interpolationAlpha)
+{
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	_RenderQueue.BeginBuild(jobSystem != nullptr ? jobSystem->GetNumberOfThreads() : 1);
+
 	if (!m_IRenderComponentIds.any())
 	{
+		_RenderQueue.EndBuild();
 		return;
 	}
 
@@ -88,47 +125,91 @@ void ECS_PoolManager::RenderEntities()
 	{
 		if (m_IRenderComponentIds.test(i))
 		{
-			ECS_ComponentPool* pComponentPool = nullptr;
-			short int storedPool = -1;
-
 			PoolComponentMask renderComponentsMask;
-			ComponentIndex transformIndex = static_cast<unsigned char>(-1); // When we enter a new Pool, we also store which Transform component has been initialized in it (only the first one, Pools shouldn't have multiple types of Transforms).
 			renderComponentsMask.set(i);
 
-			Iterator end = EndIterator(renderComponentsMask);
-			for (Iterator it = BeginIterator(renderComponentsMask); it != end; ++it)
-			{
-				if (it.m_uCurrentPoolId != storedPool)
+			ParallelForEachRange(renderComponentsMask, [this, i, jobSystem, &_RenderQueue, _interpolationAlpha](ECS_EntityPool& _EntityPool, unsigned int _uBegin, unsigned int _uEnd, const EntityComponentMask& _entityMask)
 				{
-					// We store the T Pool to directly tell it to update the T.
-					storedPool = it.m_uCurrentPoolId;
-					
-					EntityComponentMask validTransformComponentsMask = GetEntityPool(storedPool)->ConvertPoolMaskToEntityMask(m_ITransformComponentIds);
+					// We use the first Transform initialized in the Pool (Pools shouldn't have multiple types of Transforms).
+					EntityComponentMask validTransformComponentsMask = _EntityPool.ConvertPoolMaskToEntityMask(m_ITransformComponentIds);
 					if (validTransformComponentsMask.none())
 					{
-						it.AdvanceToEndOfEntityPool(); // We cannot render anything without a Transform.
-						continue;
+						return; // We cannot render anything without a Transform.
 					}
 
-					// Storing the T Index of the Transform T we will be using.
-					for (ComponentIndex i = 0; i < MAX_NUMBER_OF_COMPONENTS_INSIDE_ENTITY_POOL; i++)
+					ComponentIndex transformIndex = ECS::CONSTANTS::InvalidComponentIndex();
+					for (ComponentIndex componentIndex = 0; componentIndex < MAX_NUMBER_OF_COMPONENTS_INSIDE_ENTITY_POOL; componentIndex++)
 					{
-						if (validTransformComponentsMask.test(i))
+						if (validTransformComponentsMask.test(componentIndex))
 						{
-							transformIndex = i;
+							transformIndex = componentIndex;
 							break;
 						}
 					}
 
-					pComponentPool = GetEntityPool(storedPool)->GetComponentPool(i);
-				}
+					EntityComponentMask requiredComponentsMask = _entityMask;
+					requiredComponentsMask.set(transformIndex);
+
+					const ECS_ComponentPool* renderComponentPool = _EntityPool.GetComponentPool(i);
+					const ECS_ComponentPool* transformComponentPool = _EntityPool.m_componentPools[transformIndex];
+					std::vector<RenderCommand>& commands = _RenderQueue.GetThreadCommandList(jobSystem != nullptr ? jobSystem->GetCurrentThreadIndex() : 0);
+
+					// Component, Pool and Entity index, which is the order in which the Entities used to be rendered.
+					const uint64_t poolOrderKey = (static_cast<uint64_t>(i) << 48) | (static_cast<uint64_t>(_EntityPool.GetPoolId()) << 32);
+
+					RenderCommand command;
+					C_Transform2D interpolatedTransform;
+					for (unsigned int entityIndex = _uBegin; entityIndex < _uEnd; entityIndex++)
+					{
+						if (!_EntityPool.HasComponentsEnabled(entityIndex, requiredComponentsMask))
+						{
+							continue;
+						}
 
-				if (it.HasComponentEnabled(transformIndex))
+						const void* transform = transformComponentPool->GetElement(entityIndex);
+						if (_interpolationAlpha < 1.0f)
+						{
+							// Every Transform is a C_Transform2D, so the render Components only see the interpolated base.
+							interpolatedTransform = reinterpret_cast<const C_Transform2D*>(transform)->GetInterpolated(_interpolationAlpha);
+							transform = &interpolatedTransform;
+						}
+
+						if (renderComponentPool->BuildElementRenderCommand(entityIndex, transform, &command))
+						{
+							command.m_orderKey = poolOrderKey | entityIndex;
+							commands.push_back(command);
+						}
+					}
+				});
+		}
+	}
+
+	_RenderQueue.EndBuild();
+}
+
+void ECS_PoolManager::StoreTransformsPreviousState()
+{
+	for (unsigned int i = 0; i < MAX_TOTAL_NUMBER_OF_COMPONENTS; i++)
+	{
+		if (!m_ITransformComponentIds.test(i))
+		{
+			continue;
+		}
+
+		PoolComponentMask transformComponentMask;
+		transformComponentMask.set(i);
+
+		ParallelForEachRange(transformComponentMask, [i](ECS_EntityPool& _EntityPool, unsigned int _uBegin, unsigned int _uEnd, const EntityComponentMask& _entityMask)
+			{
+				const ECS_ComponentPool* transformComponentPool = _EntityPool.GetComponentPool(i);
+				for (unsigned int entityIndex = _uBegin; entityIndex < _uEnd; entityIndex++)
 				{
-					pComponentPool->CallStoredFunctionWithObjectParam(it.GetCurrentEntityIndex(), it.GetComponent(transformIndex));
+					if (_EntityPool.HasComponentsEnabled(entityIndex, _entityMask))
+					{
+						reinterpret_cast<C_Transform2D*>(transformComponentPool->GetElement(entityIndex))->StorePreviousState();
+					}
 				}
-			}
-		}
+			});
 	}
 }
 
@@ -165,6 +246,341 @@ ECS_EntityPool* ECS_PoolManager::GetEntityPool(PoolID _poolId)
 	return &(m_pools[_poolId]);
 }
 
+std::string ECS_PoolManager::GetPoolInfoFilePath()
+{
+	std::string filePath = Engine::CONFIGURATION_FILES_PATH;
+	filePath.append(Engine::POOL_FILE_NAME);
+	filePath.append(Engine::XML_FILE_EXTENSION);
+
+	return filePath;
+}
+std::string ECS_PoolManager::GetPoolManifestFilePath()
+{
+	std::string filePath = Engine::CONFIGURATION_FILES_PATH;
+	filePath.append(Engine::POOL_FILE_NAME);
+	filePath.append(Engine::BINARY_FILE_EXTENSION);
+
+	return filePath;
+}
+
+bool ECS_PoolManager::CommitPoolRegistration()
+{
+	if (m_uPoolRegistrationDepth == 0)
+	{
+		assert(false && "Trying to commit a Pool Registration that was never started.");
+		return false;
+	}
+
+	m_uPoolRegistrationDepth--;
+
+	if (m_uPoolRegistrationDepth > 0 || !m_poolInfoChanged)
+	{
+		return true;
+	}
+
+	return SavePoolInfo();
+}
+
+const ECS_PoolManifest& ECS_PoolManager::GetPoolManifest()
+{
+	if (m_poolManifestOutdated)
+	{
+		m_poolManifest.Close();
+		m_poolManifestBuffer = ECS_PoolManifest::Build(PoolInfoDocument.child("PoolList"));
+		m_poolManifest.OpenFromMemory(m_poolManifestBuffer.data(), m_poolManifestBuffer.size());
+		m_poolManifestOutdated = false;
+	}
+
+	return m_poolManifest;
+}
+
+/// <summary>
+/// Writes the file only if its current contents differ, so unchanged startups don't touch the disk.
+/// </summary>
+static bool WriteFileIfDifferent(const std::string& _FilePath, const char* _pData, size_t _uDataSize)
+{
+	{
+		std::ifstream existingFile(_FilePath, std::ios::binary | std::ios::ate);
+		if (existingFile.is_open() && static_cast<size_t>(existingFile.tellg()) == _uDataSize)
+		{
+			std::string existingContents(_uDataSize, '\0');
+			existingFile.seekg(0);
+			existingFile.read(existingContents.data(), _uDataSize);
+
+			if (existingFile && memcmp(existingContents.data(), _pData, _uDataSize) == 0)
+			{
+				return true;
+			}
+		}
+	}
+
+	std::ofstream file(_FilePath, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	file.write(_pData, _uDataSize);
+	return file.good();
+}
+
+bool ECS_PoolManager::SavePoolInfo()
+{
+	m_poolInfoChanged = false;
+
+	std::ostringstream poolInfoStream;
+	PoolInfoDocument.save(poolInfoStream);
+	const std::string poolInfoContents = poolInfoStream.str();
+
+	const ECS_PoolManifest& manifest = GetPoolManifest();
+
+	const bool savedPoolInfo = WriteFileIfDifferent(GetPoolInfoFilePath(), poolInfoContents.data(), poolInfoContents.size());
+
+	// No Pool was created since the manifest was mapped from its file, so the file is already up to date.
+	if (m_poolManifestBuffer.empty())
+	{
+		return savedPoolInfo && manifest.IsOpen();
+	}
+
+	const bool savedManifest = manifest.IsOpen() && WriteFileIfDifferent(GetPoolManifestFilePath(), m_poolManifestBuffer.data(), m_poolManifestBuffer.size());
+
+	// From now on the loaders read the memory-mapped file, so the buffer built from the document can be released.
+	// If the file can't be mapped, they keep reading the buffer.
+	if (savedManifest && m_poolManifest.OpenFromFile(GetPoolManifestFilePath()))
+	{
+		std::vector<char>().swap(m_poolManifestBuffer);
+	}
+	else if (!m_poolManifest.IsOpen() && !m_poolManifestBuffer.empty())
+	{
+		m_poolManifest.OpenFromMemory(m_poolManifestBuffer.data(), m_poolManifestBuffer.size());
+	}
+
+	return savedPoolInfo && savedManifest;
+}
+
+unsigned int ECS_PoolManager::GetPoolCapacity(const std::string& _PoolName, unsigned int _requestedCapacity) const
+{
+	if constexpr (!USE_RECOMMENDED_POOL_CAPACITIES)
+	{
+		return _requestedCapacity;
+	}
+
+	pugi::xml_node previousPoolNode = PreviousPoolInfoDocument.child("PoolList").find_child_by_attribute("EntityPool", "PoolName", _PoolName.c_str());
+	const unsigned int recommendedCapacity = previousPoolNode.attribute("RecommendedCapacity").as_uint(0);
+
+	if (recommendedCapacity == 0)
+	{
+		return _requestedCapacity;
+	}
+
+	// The recorded capacity can shrink the Pool to its real usage, but not below a share of what the game asked for.
+	const unsigned int minimumCapacity = std::max(1u, static_cast<unsigned int>(std::ceil(_requestedCapacity * MIN_RECOMMENDED_POOL_CAPACITY_RATIO)));
+	const unsigned int poolCapacity = std::min(std::max(recommendedCapacity, minimumCapacity), ECS::CONSTANTS::InvalidEntityIndex() - 1);
+	if (poolCapacity != _requestedCapacity)
+	{
+		printf("Pool \"%s\" created with the recorded capacity of %u Entities instead of %u.\n", _PoolName.c_str(), poolCapacity, _requestedCapacity);
+	}
+
+	return poolCapacity;
+}
+
+void ECS_PoolManager::CarryOverRecordedPoolCapacity(const std::string& _PoolName, pugi::xml_node& _PoolNode) const
+{
+	pugi::xml_node previousPoolNode = PreviousPoolInfoDocument.child("PoolList").find_child_by_attribute("EntityPool", "PoolName", _PoolName.c_str());
+	if (previousPoolNode.empty())
+	{
+		return;
+	}
+
+	// The Pool Info file is rebuilt every session, so the recorded values would be lost if we didn't copy them.
+	for (const char* attributeName : { "RecommendedCapacity", "RecordedHighWaterMark", "RecordedPeakSpawnsPerSecond", "RecordedAverageSpawnsPerSecond", "RecordedSessionSeconds" })
+	{
+		pugi::xml_attribute previousAttribute = previousPoolNode.attribute(attributeName);
+		if (!previousAttribute.empty())
+		{
+			_PoolNode.append_attribute(attributeName).set_value(previousAttribute.value());
+		}
+	}
+}
+
+#pragma endregion
+
+#pragma region Pool Capacity Recording
+
+void ECS_PoolManager::StartPoolCapacityRecording()
+{
+	m_isRecordingPoolCapacities = true;
+	m_recordedSeconds = 0;
+	m_secondsSinceLastSample = 0;
+
+	m_poolCapacityRecords.clear();
+	m_poolCapacityRecords.resize(m_pools.size());
+	for (unsigned int poolIndex = 0; poolIndex < m_pools.size(); poolIndex++)
+	{
+		m_poolCapacityRecords[poolIndex].m_uCreatedEntitiesAtStart = m_pools[poolIndex].GetTotalCreatedEntities();
+		m_poolCapacityRecords[poolIndex].m_uCreatedEntitiesAtLastSample = m_pools[poolIndex].GetTotalCreatedEntities();
+	}
+}
+
+void ECS_PoolManager::UpdatePoolCapacityRecording(float _unscaledDeltaTime)
+{
+	if (!m_isRecordingPoolCapacities)
+	{
+		return;
+	}
+
+	// Pools created after the recording started are recorded from the moment we first see them.
+	while (m_poolCapacityRecords.size() < m_pools.size())
+	{
+		PoolCapacityRecord& newRecord = m_poolCapacityRecords.emplace_back();
+		newRecord.m_uCreatedEntitiesAtStart = m_pools[m_poolCapacityRecords.size() - 1].GetTotalCreatedEntities();
+		newRecord.m_uCreatedEntitiesAtLastSample = newRecord.m_uCreatedEntitiesAtStart;
+	}
+
+	m_recordedSeconds += _unscaledDeltaTime;
+	m_secondsSinceLastSample += _unscaledDeltaTime;
+
+	// Spawn rates are sampled in windows of one second, so single frames with many spawns don't create fake peaks.
+	if (m_secondsSinceLastSample < 1.0f)
+	{
+		return;
+	}
+
+	for (unsigned int poolIndex = 0; poolIndex < m_poolCapacityRecords.size(); poolIndex++)
+	{
+		PoolCapacityRecord& record = m_poolCapacityRecords[poolIndex];
+		const unsigned int createdEntities = m_pools[poolIndex].GetTotalCreatedEntities();
+
+		record.m_peakSpawnsPerSecond = std::max(record.m_peakSpawnsPerSecond, (createdEntities - record.m_uCreatedEntitiesAtLastSample) / m_secondsSinceLastSample);
+		record.m_uCreatedEntitiesAtLastSample = createdEntities;
+	}
+
+	m_secondsSinceLastSample = 0;
+}
+
+bool ECS_PoolManager::StopPoolCapacityRecording()
+{
+	if (!m_isRecordingPoolCapacities)
+	{
+		assert(false && "Trying to stop the Pool Capacity recording but it was never started.");
+		return false;
+	}
+
+	m_isRecordingPoolCapacities = false;
+
+	pugi::xml_node poolNode = PoolInfoDocument.child("PoolList").child("EntityPool");
+	for (unsigned int poolIndex = 0; poolIndex < m_pools.size() && !poolNode.empty(); poolIndex++, poolNode = poolNode.next_sibling("EntityPool"))
+	{
+		const ECS_EntityPool& entityPool = m_pools[poolIndex];
+		const PoolCapacityRecord record = poolIndex < m_poolCapacityRecords.size() ? m_poolCapacityRecords[poolIndex] : PoolCapacityRecord();
+
+		const float averageSpawnsPerSecond = m_recordedSeconds > 0 ? (entityPool.GetTotalCreatedEntities() - record.m_uCreatedEntitiesAtStart) / m_recordedSeconds : 0.0f;
+		// Sessions shorter than a sampling window only have their average to go by.
+		const float peakSpawnsPerSecond = std::max(record.m_peakSpawnsPerSecond, averageSpawnsPerSecond);
+
+		const unsigned int highWaterMark = std::max(entityPool.GetHighWaterMark(), poolNode.attribute("RecordedHighWaterMark").as_uint(0));
+		const unsigned int recommendedCapacity = std::max(1u, static_cast<unsigned int>(std::ceil(highWaterMark * (1.0f + RECOMMENDED_POOL_CAPACITY_HEADROOM))));
+
+		auto setAttribute = [&poolNode](const char* _AttributeName, const std::string& _Value)
+			{
+				pugi::xml_attribute attribute = poolNode.attribute(_AttributeName);
+				if (attribute.empty())
+				{
+					attribute = poolNode.append_attribute(_AttributeName);
+				}
+				attribute.set_value(_Value.c_str());
+			};
+
+		setAttribute("RecommendedCapacity", std::to_string(recommendedCapacity));
+		setAttribute("RecordedHighWaterMark", std::to_string(highWaterMark));
+		setAttribute("RecordedPeakSpawnsPerSecond", std::to_string(peakSpawnsPerSecond));
+		setAttribute("RecordedAverageSpawnsPerSecond", std::to_string(averageSpawnsPerSecond));
+		setAttribute("RecordedSessionSeconds", std::to_string(m_recordedSeconds));
+	}
+
+	return SavePoolInfo();
+}
+
+#pragma endregion
+
+#pragma region Memory Accounting
+
+ECS_MemoryReport ECS_PoolManager::GetMemoryReport() const
+{
+	ECS_MemoryReport report;
+	report.m_pools.reserve(m_pools.size());
+
+	// Pools are appended to the Pool Info Document in the same order they are created, so we can walk both at the same time.
+	pugi::xml_node poolNode = PoolInfoDocument.child("PoolList").child("EntityPool");
+
+	for (unsigned int poolIndex = 0; poolIndex < m_pools.size(); poolIndex++, poolNode = poolNode.next_sibling("EntityPool"))
+	{
+		const ECS_EntityPool& entityPool = m_pools[poolIndex];
+
+		ECS_PoolMemoryReport& poolReport = report.m_pools.emplace_back();
+		poolReport.m_poolName = poolNode.attribute("PoolName").as_string();
+		poolReport.m_poolId = entityPool.GetPoolId();
+		poolReport.m_uCapacity = entityPool.GetMaxNumberOfEntities();
+		poolReport.m_uLiveEntities = entityPool.GetNumberOfLiveEntities();
+		poolReport.m_uHighWaterMark = entityPool.GetHighWaterMark();
+		poolReport.m_uFreeListLength = entityPool.GetFreeListLength();
+		poolReport.m_bookkeepingBytes = entityPool.GetBookkeepingMemoryUsage();
+
+		poolReport.m_components.resize(entityPool.GetComponentPoolsCount());
+		for (pugi::xml_node componentNode = poolNode.child("Components").child("ECS_Component"); componentNode; componentNode = componentNode.next_sibling("ECS_Component"))
+		{
+			const unsigned int componentIndex = componentNode.attribute("ComponentIndex").as_uint();
+			if (componentIndex < poolReport.m_components.size())
+			{
+				poolReport.m_components[componentIndex].m_componentName = componentNode.attribute("ComponentName").as_string();
+			}
+		}
+
+		for (unsigned int componentIndex = 0; componentIndex < poolReport.m_components.size(); componentIndex++)
+		{
+			const ECS_ComponentPool* componentPool = entityPool.m_componentPools[componentIndex];
+			ECS_ComponentMemoryReport& componentReport = poolReport.m_components[componentIndex];
+
+			componentReport.m_componentIndex = static_cast<ComponentIndex>(componentIndex);
+			componentReport.m_uComponentSize = componentPool->m_uComponentSize;
+			componentReport.m_reservedBytes = componentPool->GetReservedMemory();
+			componentReport.m_tracksHeapMemory = componentPool->TracksHeapMemory();
+		}
+
+		// Counting live Components with a single pass over the Entities.
+		for (unsigned int entityIndex = 0; entityIndex < entityPool.GetHighWaterMark(); entityIndex++)
+		{
+			if (entityPool.IsEntityDeleted(entityIndex))
+			{
+				continue;
+			}
+
+			entityPool.m_entities[entityIndex].m_componentMask.ForEachSetBit([&poolReport, &entityPool, entityIndex](const unsigned int _componentIndex)
+				{
+					ECS_ComponentMemoryReport& componentReport = poolReport.m_components[_componentIndex];
+					componentReport.m_uLiveComponents++;
+					componentReport.m_heapBytes += entityPool.m_componentPools[_componentIndex]->GetElementHeapMemoryUsage(entityIndex);
+				});
+		}
+
+		for (ECS_ComponentMemoryReport& componentReport : poolReport.m_components)
+		{
+			componentReport.m_liveBytes = static_cast<size_t>(componentReport.m_uComponentSize) * componentReport.m_uLiveComponents;
+		}
+	}
+
+	return report;
+}
+
+bool ECS_PoolManager::SaveMemoryReport() const
+{
+	std::string filePath = Engine::CONFIGURATION_FILES_PATH;
+	filePath.append(Engine::MEMORY_REPORT_FILE_NAME);
+	filePath.append(Engine::XML_FILE_EXTENSION);
+
+	return GetMemoryReport().SaveToFile(filePath);
+}
+
 #pragma endregion
 
 #pragma region Iterator
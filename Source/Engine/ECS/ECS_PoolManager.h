@@ -3,13 +3,21 @@
 #include "ECS_Configuration.h"
 #include "ECS_MACROS.h"
 #include "ECS_EntityPool.h"
+#include "ECS_MemoryReport.h"
+#include "ECS_PoolManifest.h"
+#include "ECS_SystemScheduler.h"
+#include "ECS_BehaviourScheduler.h"
+#include "Engine/Events/EventBus.h"
+#include "Engine/Rendering/RenderQueue.h"
 #include "Engine/Engine.h"
 #include "Engine/Util/XML/XML_File_Handler.h"
 #include "Engine/ExternalLibraries/Pugixml/pugixml.hpp"
 #include <typeinfo>
+#include <type_traits>
+#include <algorithm>
+#include <utility>
 #include <assert.h>
 #include <vector>
-#include <bitset>
 #include <string>
 
 class Engine;
@@ -18,16 +26,45 @@ class ECS_EntityPool;
 class ECS_PoolManager
 {
 	pugi::xml_document PoolInfoDocument;
+	pugi::xml_document PreviousPoolInfoDocument; // Pool Info saved by the previous session. Used to read the recommended capacities.
+
+	// Declared before the Pools, so it's destroyed after the Components that own Behaviours.
+	ECS_BehaviourScheduler m_behaviourScheduler;
+	EventBus m_eventBus;
 
 	std::vector<ECS_EntityPool> m_pools;
-	std::vector<std::bitset<MAX_TOTAL_NUMBER_OF_COMPONENTS>> m_componentsInEachPool;
+	std::vector<PoolComponentMask> m_componentsInEachPool;
 
 	// Vectors storing which components implement which Interfaces.
 	PoolComponentMask m_IUpdateComponentIds;
+	PoolComponentMask m_IThreadSafeUpdateComponentIds;
 	PoolComponentMask m_ITransformComponentIds;
 	PoolComponentMask m_IRenderComponentIds;
 	PoolComponentMask m_ISerializableComponentIds;
 
+	// Pool registration.
+	unsigned int m_uPoolRegistrationDepth{ 0 };
+	bool m_poolInfoChanged{ false };
+
+	std::vector<char> m_poolManifestBuffer;
+	ECS_PoolManifest m_poolManifest;
+	bool m_poolManifestOutdated{ true };
+
+	// Pool capacity recording.
+	struct PoolCapacityRecord
+	{
+		unsigned int m_uCreatedEntitiesAtStart{ 0 };
+		unsigned int m_uCreatedEntitiesAtLastSample{ 0 };
+		float m_peakSpawnsPerSecond{ 0 };
+	};
+	std::vector<PoolCapacityRecord> m_poolCapacityRecords;
+	bool m_isRecordingPoolCapacities{ false };
+	float m_recordedSeconds{ 0 };
+	float m_secondsSinceLastSample{ 0 };
+
+	ECS_SystemScheduler m_systemScheduler;
+	RenderQueue m_renderQueue;
+
 	static inline ECS_PoolManager* Instance{ nullptr };
 
 	ECS_PoolManager();
@@ -81,8 +118,17 @@ public:
 		{
 			m_IUpdateComponentIds.set(ECS::GetComponentId<FirstComponent>());
 		}
+		if constexpr (ECS_INTERNAL::Implements_IECS_ThreadSafeUpdate<FirstComponent>())
+		{
+			static_assert(ECS_INTERNAL::Implements_IECS_Update<FirstComponent>(), "IECS_ThreadSafeUpdate only makes sense for Components that also implement IECS_Update.");
+			m_IThreadSafeUpdateComponentIds.set(ECS::GetComponentId<FirstComponent>());
+		}
 		if constexpr (ECS_INTERNAL::Implements_IECS_Transform<FirstComponent>())
 		{
+			// Interpolation, rendering and the previous state of the fixed step read every Transform as a C_Transform2D, so it has to be its first base.
+			// A virtual table would sit before it.
+			static_assert(std::is_base_of_v<C_Transform2D, FirstComponent> && !std::is_polymorphic_v<FirstComponent>,
+				"Every IECS_Transform must derive from C_Transform2D without virtual functions: the Pool Manager reads every Transform through its layout.");
 			m_ITransformComponentIds.set(ECS::GetComponentId<FirstComponent>());
 		}
 		if constexpr (ECS_INTERNAL::Implements_IECS_Render<FirstComponent>())
@@ -101,7 +147,20 @@ public:
 	}
 
 	void UpdateComponents(float _deltaTime);
+	/// <summary>
+	/// Builds the Render Commands of every visible Entity and blits them on the Engine screen.
+	/// </summary>
 	void RenderEntities();
+	/// <summary>
+	/// Build phase of the rendering. Every IECS_Render Component with a Transform adds its Render Command to the queue.
+	/// The Entity ranges are processed in parallel, and the queue ends up sorted by layer and then by Component, Pool and Entity index.
+	/// <para>Transforms are interpolated between their previous and current state with _interpolationAlpha.</para>
+	/// </summary>
+	void BuildRenderQueue(RenderQueue& _RenderQueue, float _interpolationAlpha = 1.0f);
+	/// <summary>
+	/// Saves the current state of every Transform as its previous state. Called at the beginning of every fixed step.
+	/// </summary>
+	void StoreTransformsPreviousState();
 
 	template<typename Component>
 	EntityID FindComponentOwnerEntity(Component* _component)
@@ -137,6 +196,9 @@ public:
 
 		assert(_maxNumberOfEntities > 0 && "Trying to create an Entity Pool with 0 maximum Entities.");
 
+		// A previous recording session may have measured how many Entities this Pool really needs.
+		const unsigned int poolCapacity = GetPoolCapacity(_PoolName, _maxNumberOfEntities);
+
 		PoolID newPoolId = HowManyInitializedEPools();
 
 		assert(newPoolId < ECS::CONSTANTS::InvalidPoolId() && "Cannot create more than the maximum number of Entity Pools allowed (4095).");
@@ -154,22 +216,25 @@ public:
 		// Creating the Pool.
 		m_pools.push_back(ECS_EntityPool());
 		void* locationOfNewPool = reinterpret_cast<void*>(&m_pools.data()[m_pools.size() - 1]);
-		ECS_EntityPool::CreateEntityPoolAtLocation<ComponentTypes...>(locationOfNewPool, this, _maxNumberOfEntities, newPoolId);
+		ECS_EntityPool::CreateEntityPoolAtLocation<ComponentTypes...>(locationOfNewPool, this, poolCapacity, newPoolId);
 
 		// Extending our Pool Info Document
 		pugi::xml_node poolNode = PoolInfoDocument.child("PoolList").append_child("EntityPool");
 		poolNode.append_attribute("PoolName").set_value(_PoolName);
 		poolNode.append_attribute("PoolID").set_value(std::to_string(newPoolId));
+		poolNode.append_attribute("Capacity").set_value(std::to_string(poolCapacity).c_str());
+		CarryOverRecordedPoolCapacity(_PoolName, poolNode);
 
 		pugi::xml_node componentsListNode = poolNode.append_child("Components");
 		CreatePoolInfoInXMLDocument<ComponentTypes...>(componentsListNode, reinterpret_cast<ECS_EntityPool*>(locationOfNewPool));
 
-		// Saving the XML Document.
-		std::string xml_document_filePath = Engine::CONFIGURATION_FILES_PATH;
-		xml_document_filePath.append(Engine::POOL_FILE_NAME);
-		xml_document_filePath.append(Engine::XML_FILE_EXTENSION);
-
-		XML_UTIL::SaveXMLFile(xml_document_filePath.c_str(), PoolInfoDocument);
+		// Saving the XML Document, unless we are in the middle of a Pool Registration.
+		m_poolInfoChanged = true;
+		m_poolManifestOutdated = true;
+		if (m_uPoolRegistrationDepth == 0)
+		{
+			SavePoolInfo();
+		}
 
 		return newPoolId;
 	}
@@ -191,6 +256,205 @@ public:
 
 	inline const pugi::xml_node& GetPoolListNode() { return PoolInfoDocument.child("PoolList"); };
 
+	static std::string GetPoolInfoFilePath();
+	static std::string GetPoolManifestFilePath();
+
+	/// <summary>
+	/// Starts a Pool Registration. Pools created until the matching CommitPoolRegistration are only saved to disk once, when it commits.
+	/// Registrations can be nested, only the outermost one saves.
+	/// </summary>
+	inline void BeginPoolRegistration() { m_uPoolRegistrationDepth++; };
+	/// <summary>
+	/// Ends a Pool Registration. If any Pool was created, it saves ECS_Pools_Information.xml and its binary manifest,
+	/// but only rewrites the files whose contents actually changed.
+	/// </summary>
+	bool CommitPoolRegistration();
+
+	/// <summary>
+	/// Binary view of the Pool Information document, meant for loaders that only need to look up Pools and Component Indexes.
+	/// <para>Once a Pool Registration commits, it is the memory-mapped manifest file. Pools created outside a registration rebuild it in memory.</para>
+	/// </summary>
+	const ECS_PoolManifest& GetPoolManifest();
+
+private:
+	bool SavePoolInfo();
+	unsigned int GetPoolCapacity(const std::string& _PoolName, unsigned int _requestedCapacity) const;
+	void CarryOverRecordedPoolCapacity(const std::string& _PoolName, pugi::xml_node& _PoolNode) const;
+
+#pragma endregion
+
+#pragma region Parallel Iteration
+
+public:
+	/// <summary>
+	/// Calls _function for every Entity that has all the given Components enabled, splitting the work across the JobSystem threads.
+	/// <para>_function receives the Components by reference, optionally preceded by the EntityID: fn(Components&...) or fn(EntityID, Components&...).</para>
+	/// <para>Every Entity Pool is split into disjoint ranges of _uGrainSize Entity slots, so each call gets the Components of a different Entity.
+	/// _function must not create or destroy Entities, nor add or remove Components.</para>
+	/// </summary>
+	template<typename... Components, typename Function>
+	void ParallelForEach(Function&& _function, unsigned int _uGrainSize = PARALLEL_FOR_EACH_GRAIN_SIZE)
+	{
+		static_assert(sizeof...(Components) > 0, "ParallelForEach needs at least one Component type.");
+
+		if (!ECS::HaveComponentsBeenInitialized<Components...>())
+		{
+			return;
+		}
+
+		PoolComponentMask mask;
+		ECS::SetPoolComponentMask<Components...>(mask);
+
+		ParallelForEachRange(mask, [&_function](ECS_EntityPool& _EntityPool, unsigned int _uBegin, unsigned int _uEnd, const EntityComponentMask& _entityMask)
+			{
+				ECS_ComponentPool* componentPools[]{ _EntityPool.m_componentPools[_EntityPool.GetComponentIndex<Components>()]... };
+
+				for (unsigned int entityIndex = _uBegin; entityIndex < _uEnd; entityIndex++)
+				{
+					if (!_EntityPool.HasComponentsEnabled(entityIndex, _entityMask))
+					{
+						continue;
+					}
+
+					[&]<size_t... Indexes>(std::index_sequence<Indexes...>)
+					{
+						if constexpr (std::is_invocable_v<Function&, EntityID, Components&...>)
+						{
+							_function(_EntityPool.m_entities[entityIndex].m_id, *reinterpret_cast<Components*>(componentPools[Indexes]->GetElement(entityIndex))...);
+						}
+						else
+						{
+							_function(*reinterpret_cast<Components*>(componentPools[Indexes]->GetElement(entityIndex))...);
+						}
+					}(std::index_sequence_for<Components...>());
+				}
+			}, _uGrainSize);
+	}
+
+	/// <summary>
+	/// Untyped version of ParallelForEach. Calls _function(ECS_EntityPool&, begin, end, entityMask) for disjoint ranges of Entity slots
+	/// of every Entity Pool that implements all the Components of _mask. The Entities of a range still have to be checked with HasComponentsEnabled.
+	/// </summary>
+	template<typename Function>
+	void ParallelForEachRange(const PoolComponentMask& _mask, Function&& _function, unsigned int _uGrainSize = PARALLEL_FOR_EACH_GRAIN_SIZE)
+	{
+		struct EntityRange
+		{
+			PoolID m_poolId;
+			unsigned int m_uBegin;
+			unsigned int m_uEnd;
+			EntityComponentMask m_entityMask;
+		};
+
+		_uGrainSize = _uGrainSize > 0 ? _uGrainSize : 1;
+
+		std::vector<EntityRange> ranges;
+		for (PoolID poolId = 0; poolId < HowManyInitializedEPools(); poolId++)
+		{
+			if (!_mask.IsSubsetOf(m_componentsInEachPool[poolId]))
+			{
+				continue;
+			}
+
+			const EntityComponentMask entityMask = m_pools[poolId].ConvertPoolMaskToEntityMask(_mask);
+			const unsigned int numberOfSlots = m_pools[poolId].GetHighWaterMark();
+			for (unsigned int begin = 0; begin < numberOfSlots; begin += _uGrainSize)
+			{
+				ranges.push_back({ poolId, begin, std::min(begin + _uGrainSize, numberOfSlots), entityMask });
+			}
+		}
+
+		auto processRanges = [this, &ranges, &_function](unsigned int _uFirstRange, unsigned int _uLastRange)
+			{
+				for (unsigned int rangeIndex = _uFirstRange; rangeIndex < _uLastRange; rangeIndex++)
+				{
+					const EntityRange& range = ranges[rangeIndex];
+					_function(m_pools[range.m_poolId], range.m_uBegin, range.m_uEnd, range.m_entityMask);
+				}
+			};
+
+		if (JobSystem* jobSystem = JobSystem::GetInstance())
+		{
+			jobSystem->ParallelFor(static_cast<unsigned int>(ranges.size()), 1, processRanges);
+		}
+		else
+		{
+			processRanges(0, static_cast<unsigned int>(ranges.size()));
+		}
+	}
+
+#pragma endregion
+
+#pragma region System Management
+
+public:
+	/// <summary>
+	/// Registers a System at the end of the given phase. The System declares the Components it uses through its "Reads" and "Writes" ECS_ComponentLists,
+	/// which decide which Systems can run at the same time.
+	/// </summary>
+	template<typename System, typename... ConstructorArgs>
+	inline System* RegisterSystem(ECS_SystemPhase _phase, ConstructorArgs&&... _constructorArgs)
+		{ return m_systemScheduler.RegisterSystem<System>(_phase, std::forward<ConstructorArgs>(_constructorArgs)...); };
+
+	inline void RunSystems(ECS_SystemPhase _phase, float _deltaTime) { m_systemScheduler.RunSystems(_phase, this, _deltaTime); };
+
+#pragma endregion
+
+#pragma region Behaviours
+
+public:
+	/// <summary>
+	/// Schedules a Component Behaviour. It first runs in the next UpdateBehaviours, and then every time it's woken up.
+	/// </summary>
+	inline void StartBehaviour(ECS_Behaviour& _behaviour) { m_behaviourScheduler.Start(_behaviour); };
+	inline void UpdateBehaviours(float _deltaTime) { m_behaviourScheduler.Update(_deltaTime); };
+	inline const ECS_BehaviourScheduler& GetBehaviourScheduler() const { return m_behaviourScheduler; };
+
+#pragma endregion
+
+#pragma region Events
+
+public:
+	/// <summary>
+	/// Events exchanged by Systems and Components. Systems can Publish from any worker, and each event type is drained by its single consumer.
+	/// </summary>
+	inline EventBus* GetEventBus() { return &m_eventBus; };
+
+#pragma endregion
+
+#pragma region Pool Capacity Recording
+
+public:
+	/// <summary>
+	/// Starts tracking the high-water mark and spawn rate of every Entity Pool.
+	/// </summary>
+	void StartPoolCapacityRecording();
+	/// <summary>
+	/// Must be called once per frame while recording, with the unscaled delta time.
+	/// </summary>
+	void UpdatePoolCapacityRecording(float _unscaledDeltaTime);
+	/// <summary>
+	/// Stops the recording and writes the recorded values and a RecommendedCapacity for every Entity Pool into the Pool Information file.
+	/// High-water marks recorded by previous sessions are kept if they were higher, so capacities never shrink below what a past session needed.
+	/// </summary>
+	bool StopPoolCapacityRecording();
+	inline bool IsRecordingPoolCapacities() const { return m_isRecordingPoolCapacities; };
+
+#pragma endregion
+
+#pragma region Memory Accounting
+
+public:
+	/// <summary>
+	/// Builds a snapshot of the memory reserved and used by every Entity Pool and each of its Component Pools.
+	/// Heap memory is only counted for Components that implement IECS_HeapMemory.
+	/// </summary>
+	ECS_MemoryReport GetMemoryReport() const;
+	/// <summary>
+	/// Saves the current memory report next to the Pool Information file.
+	/// </summary>
+	bool SaveMemoryReport() const;
+
 #pragma endregion
 
 #pragma region Iterator
@@ -354,7 +618,7 @@ public:
 			}
 			else
 			{
-				return m_componentMask == (m_componentMask & m_pPoolManager->m_componentsInEachPool[_poolId]);
+				return m_componentMask.IsSubsetOf(m_pPoolManager->m_componentsInEachPool[_poolId]);
 			}
 		}
 	};
@@ -0,0 +1,328 @@
+#include "ECS_PoolManifest.h"
+#include "ECS_Constants.h"
+#include <assert.h>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#pragma region Building
+
+std::vector<char> ECS_PoolManifest::Build(const pugi::xml_node& _PoolListNode)
+{
+	std::vector<PoolEntry> pools;
+	std::vector<ComponentEntry> components;
+	std::string stringTable;
+
+	auto addString = [&stringTable](const char* _String, uint32_t& _uOffset, uint32_t& _uLength)
+		{
+			_uOffset = static_cast<uint32_t>(stringTable.size());
+			_uLength = static_cast<uint32_t>(strlen(_String));
+			stringTable.append(_String);
+		};
+
+	for (pugi::xml_node poolNode : _PoolListNode.children("EntityPool"))
+	{
+		PoolEntry& pool = pools.emplace_back();
+		addString(poolNode.attribute("PoolName").as_string(), pool.m_uNameOffset, pool.m_uNameLength);
+		pool.m_poolId = static_cast<uint16_t>(poolNode.attribute("PoolID").as_uint(ECS::CONSTANTS::InvalidPoolId()));
+		pool.m_uCapacity = poolNode.attribute("Capacity").as_uint(0);
+		pool.m_uFirstComponent = static_cast<uint32_t>(components.size());
+
+		for (pugi::xml_node componentNode : poolNode.child("Components").children("ECS_Component"))
+		{
+			ComponentEntry& component = components.emplace_back();
+			addString(componentNode.attribute("ComponentName").as_string(), component.m_uNameOffset, component.m_uNameLength);
+			component.m_componentIndex = componentNode.attribute("ComponentIndex").as_uint(ECS::CONSTANTS::InvalidComponentIndex());
+		}
+
+		pool.m_uNumberOfComponents = static_cast<uint16_t>(components.size() - pool.m_uFirstComponent);
+	}
+
+	Header header;
+	header.m_magicNumber = MAGIC_NUMBER;
+	header.m_version = VERSION;
+	header.m_uNumberOfPools = static_cast<uint32_t>(pools.size());
+	header.m_uNumberOfComponents = static_cast<uint32_t>(components.size());
+	header.m_uStringTableSize = static_cast<uint32_t>(stringTable.size());
+
+	std::vector<char> result(sizeof(Header) + pools.size() * sizeof(PoolEntry) + components.size() * sizeof(ComponentEntry) + stringTable.size());
+	char* writeHead = result.data();
+
+	memcpy(writeHead, &header, sizeof(Header));
+	writeHead += sizeof(Header);
+	memcpy(writeHead, pools.data(), pools.size() * sizeof(PoolEntry));
+	writeHead += pools.size() * sizeof(PoolEntry);
+	memcpy(writeHead, components.data(), components.size() * sizeof(ComponentEntry));
+	writeHead += components.size() * sizeof(ComponentEntry);
+	memcpy(writeHead, stringTable.data(), stringTable.size());
+
+	return result;
+}
+
+#pragma endregion
+
+#pragma region Opening & Closing
+
+ECS_PoolManifest::~ECS_PoolManifest()
+{
+	Close();
+}
+
+bool ECS_PoolManifest::OpenFromMemory(const char* _pData, size_t _uDataSize)
+{
+	Close();
+
+	m_pData = _pData;
+	m_uDataSize = _uDataSize;
+
+	if (!IsValid())
+	{
+		assert(false && "Trying to open a Pool Manifest from a buffer that doesn't contain a valid manifest.");
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+bool ECS_PoolManifest::OpenFromFile(const std::string& _FilePath)
+{
+	Close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(_FilePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	void* mappedFile = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (mappedFile == nullptr)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	m_pFileHandle = file;
+	m_pMappingHandle = mapping;
+	m_pMappedFile = mappedFile;
+	m_uDataSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+	int file = open(_FilePath.c_str(), O_RDONLY);
+	if (file < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStats;
+	if (fstat(file, &fileStats) != 0 || fileStats.st_size == 0)
+	{
+		close(file);
+		return false;
+	}
+
+	void* mappedFile = mmap(nullptr, static_cast<size_t>(fileStats.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	close(file); // The mapping keeps its own reference to the file.
+
+	if (mappedFile == MAP_FAILED)
+	{
+		return false;
+	}
+
+	m_pMappedFile = mappedFile;
+	m_uDataSize = static_cast<size_t>(fileStats.st_size);
+#endif
+
+	m_pData = static_cast<const char*>(m_pMappedFile);
+
+	if (!IsValid())
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void ECS_PoolManifest::Close()
+{
+	if (m_pMappedFile != nullptr)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(m_pMappedFile);
+		CloseHandle(static_cast<HANDLE>(m_pMappingHandle));
+		CloseHandle(static_cast<HANDLE>(m_pFileHandle));
+#else
+		munmap(m_pMappedFile, m_uDataSize);
+#endif
+	}
+
+	m_pMappedFile = nullptr;
+	m_pMappingHandle = nullptr;
+	m_pFileHandle = nullptr;
+	m_pData = nullptr;
+	m_uDataSize = 0;
+}
+
+bool ECS_PoolManifest::IsValid() const
+{
+	if (m_pData == nullptr || m_uDataSize < sizeof(Header))
+	{
+		return false;
+	}
+
+	const Header& header = GetHeader();
+	if (header.m_magicNumber != MAGIC_NUMBER || header.m_version != VERSION)
+	{
+		return false;
+	}
+
+	const size_t expectedSize = sizeof(Header) + static_cast<size_t>(header.m_uNumberOfPools) * sizeof(PoolEntry)
+		+ static_cast<size_t>(header.m_uNumberOfComponents) * sizeof(ComponentEntry) + header.m_uStringTableSize;
+	if (expectedSize != m_uDataSize)
+	{
+		return false;
+	}
+
+	// Checking every offset once here, so queries don't have to.
+	for (unsigned int poolIndex = 0; poolIndex < header.m_uNumberOfPools; poolIndex++)
+	{
+		const PoolEntry& pool = GetPoolTable()[poolIndex];
+		if (static_cast<size_t>(pool.m_uNameOffset) + pool.m_uNameLength > header.m_uStringTableSize
+			|| static_cast<size_t>(pool.m_uFirstComponent) + pool.m_uNumberOfComponents > header.m_uNumberOfComponents)
+		{
+			return false;
+		}
+	}
+	for (unsigned int componentIndex = 0; componentIndex < header.m_uNumberOfComponents; componentIndex++)
+	{
+		const ComponentEntry& component = GetComponentTable()[componentIndex];
+		if (static_cast<size_t>(component.m_uNameOffset) + component.m_uNameLength > header.m_uStringTableSize)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+#pragma endregion
+
+#pragma region Queries
+
+const ECS_PoolManifest::PoolEntry* ECS_PoolManifest::GetPool(unsigned int _poolIndex) const
+{
+	if (_poolIndex >= GetNumberOfPools())
+	{
+		return nullptr;
+	}
+
+	return &GetPoolTable()[_poolIndex];
+}
+
+const ECS_PoolManifest::PoolEntry* ECS_PoolManifest::FindPoolByName(std::string_view _PoolName) const
+{
+	for (unsigned int poolIndex = 0; poolIndex < GetNumberOfPools(); poolIndex++)
+	{
+		const PoolEntry* pool = &GetPoolTable()[poolIndex];
+		if (GetPoolName(pool) == _PoolName)
+		{
+			return pool;
+		}
+	}
+
+	return nullptr;
+}
+
+const ECS_PoolManifest::PoolEntry* ECS_PoolManifest::FindPoolById(PoolID _poolId) const
+{
+	// Pools are stored in creation order, so the Id is usually also the index.
+	if (const PoolEntry* pool = GetPool(_poolId); pool != nullptr && pool->m_poolId == _poolId)
+	{
+		return pool;
+	}
+
+	for (unsigned int poolIndex = 0; poolIndex < GetNumberOfPools(); poolIndex++)
+	{
+		if (GetPoolTable()[poolIndex].m_poolId == _poolId)
+		{
+			return &GetPoolTable()[poolIndex];
+		}
+	}
+
+	return nullptr;
+}
+
+std::string_view ECS_PoolManifest::GetPoolName(const PoolEntry* _pPool) const
+{
+	if (_pPool == nullptr)
+	{
+		return std::string_view();
+	}
+
+	return std::string_view(GetStringTable() + _pPool->m_uNameOffset, _pPool->m_uNameLength);
+}
+
+std::string_view ECS_PoolManifest::GetComponentName(const PoolEntry* _pPool, ComponentIndex _componentIndex) const
+{
+	if (_pPool == nullptr)
+	{
+		return std::string_view();
+	}
+
+	const ComponentEntry* components = GetComponentTable() + _pPool->m_uFirstComponent;
+	for (unsigned int i = 0; i < _pPool->m_uNumberOfComponents; i++)
+	{
+		if (components[i].m_componentIndex == _componentIndex)
+		{
+			return std::string_view(GetStringTable() + components[i].m_uNameOffset, components[i].m_uNameLength);
+		}
+	}
+
+	return std::string_view();
+}
+
+ComponentIndex ECS_PoolManifest::FindComponentIndex(const PoolEntry* _pPool, std::string_view _ComponentName) const
+{
+	if (_pPool == nullptr)
+	{
+		return ECS::CONSTANTS::InvalidComponentIndex();
+	}
+
+	const ComponentEntry* components = GetComponentTable() + _pPool->m_uFirstComponent;
+	for (unsigned int i = 0; i < _pPool->m_uNumberOfComponents; i++)
+	{
+		if (std::string_view(GetStringTable() + components[i].m_uNameOffset, components[i].m_uNameLength) == _ComponentName)
+		{
+			return static_cast<ComponentIndex>(components[i].m_componentIndex);
+		}
+	}
+
+	return ECS::CONSTANTS::InvalidComponentIndex();
+}
+
+#pragma endregion
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "ECS_Typedefs.h"
+#include "Engine/ExternalLibraries/Pugixml/pugixml.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// <summary>
+/// Read-only view over the binary version of ECS_Pools_Information.
+/// <para>The manifest is a flat block: a header, a table of pools, a table of components and a string table.
+/// It can be viewed straight from a memory-mapped file or from a buffer, without building any DOM.</para>
+/// </summary>
+class ECS_PoolManifest
+{
+public:
+	static constexpr uint32_t MAGIC_NUMBER{ 0x4D534345 }; // "ECSM"
+	static constexpr uint32_t VERSION{ 1 };
+
+	struct Header
+	{
+		uint32_t m_magicNumber;
+		uint32_t m_version;
+		uint32_t m_uNumberOfPools;
+		uint32_t m_uNumberOfComponents;
+		uint32_t m_uStringTableSize;
+	};
+
+	struct PoolEntry
+	{
+		uint32_t m_uNameOffset;
+		uint32_t m_uNameLength;
+		uint32_t m_uFirstComponent; // Index of the first ComponentEntry of this pool.
+		uint32_t m_uCapacity;
+		uint16_t m_poolId;
+		uint16_t m_uNumberOfComponents;
+	};
+
+	struct ComponentEntry
+	{
+		uint32_t m_uNameOffset;
+		uint32_t m_uNameLength;
+		uint32_t m_componentIndex;
+	};
+
+private:
+	const char* m_pData{ nullptr };
+	size_t m_uDataSize{ 0 };
+
+	// Only used when the manifest has been opened from a file.
+	void* m_pMappedFile{ nullptr };
+	void* m_pFileHandle{ nullptr };
+	void* m_pMappingHandle{ nullptr };
+
+public:
+	ECS_PoolManifest() {};
+	ECS_PoolManifest(const ECS_PoolManifest&) = delete;
+	ECS_PoolManifest& operator=(const ECS_PoolManifest&) = delete;
+	~ECS_PoolManifest();
+
+	/// <summary>
+	/// Builds the binary manifest from the "PoolList" node of the Pool Information document.
+	/// </summary>
+	static std::vector<char> Build(const pugi::xml_node& _PoolListNode);
+
+	/// <summary>
+	/// Views a manifest stored in memory. The buffer must outlive this object or the next call to Open.
+	/// </summary>
+	bool OpenFromMemory(const char* _pData, size_t _uDataSize);
+	/// <summary>
+	/// Memory-maps a manifest file. The mapping is released when the manifest is closed or destroyed.
+	/// </summary>
+	bool OpenFromFile(const std::string& _FilePath);
+	void Close();
+
+	inline bool IsOpen() const { return m_pData != nullptr; };
+
+	inline const Header& GetHeader() const { return *reinterpret_cast<const Header*>(m_pData); };
+	inline unsigned int GetNumberOfPools() const { return IsOpen() ? GetHeader().m_uNumberOfPools : 0; };
+
+	const PoolEntry* GetPool(unsigned int _poolIndex) const;
+	const PoolEntry* FindPoolByName(std::string_view _PoolName) const;
+	const PoolEntry* FindPoolById(PoolID _poolId) const;
+
+	std::string_view GetPoolName(const PoolEntry* _pPool) const;
+	std::string_view GetComponentName(const PoolEntry* _pPool, ComponentIndex _componentIndex) const;
+
+	/// <summary>
+	/// Returns the index of a Component inside the given pool, or InvalidComponentIndex if the pool doesn't have it.
+	/// </summary>
+	ComponentIndex FindComponentIndex(const PoolEntry* _pPool, std::string_view _ComponentName) const;
+
+private:
+	inline const PoolEntry* GetPoolTable() const { return reinterpret_cast<const PoolEntry*>(m_pData + sizeof(Header)); };
+	inline const ComponentEntry* GetComponentTable() const
+		{ return reinterpret_cast<const ComponentEntry*>(m_pData + sizeof(Header) + GetHeader().m_uNumberOfPools * sizeof(PoolEntry)); };
+	inline const char* GetStringTable() const
+		{ return m_pData + sizeof(Header) + GetHeader().m_uNumberOfPools * sizeof(PoolEntry) + GetHeader().m_uNumberOfComponents * sizeof(ComponentEntry); };
+
+	bool IsValid() const;
+};
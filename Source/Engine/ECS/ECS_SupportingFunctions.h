@@ -39,6 +39,12 @@ struct ECS_INTERNAL
     return std::is_base_of<IECS_Update, T>::value;
   }
 
+  template<typename T>
+  consteval static bool Implements_IECS_ThreadSafeUpdate()
+  {
+    return std::is_base_of<IECS_ThreadSafeUpdate, T>::value;
+  }
+
   template<typename T>
   static void DelayedUpdater(void* _ptr, float _deltaTime)
   {
@@ -114,6 +120,19 @@ struct ECS_INTERNAL
     }
   }
 
+  template<typename T>
+  static bool DelayedFunctionBuildRenderCommand(const void* _objectPtr, const void* _transformPtr, RenderCommand* _command)
+  {
+    if constexpr (Implements_IECS_Render<T>())
+    {
+      return reinterpret_cast<const T*>(_objectPtr)->BuildRenderCommand(reinterpret_cast<const C_Transform2D*>(_transformPtr), *_command);
+    }
+    else
+    {
+      return false;
+    }
+  }
+
   template<typename T>
   consteval static bool Implements_ECS_Serialization()
   {
@@ -147,6 +166,45 @@ struct ECS_INTERNAL
   }
 
 
+  template<typename T>
+  consteval static bool Implements_IECS_HeapMemory()
+  {
+    return std::is_base_of<IECS_HeapMemory, T>::value;
+  }
+
+  template<typename T>
+  static size_t DelayedFunctionHeapMemory(const void* _objectPtr)
+  {
+    if constexpr (Implements_IECS_HeapMemory<T>())
+    {
+      return reinterpret_cast<const T*>(_objectPtr)->GetHeapMemoryUsage();
+    }
+    else
+    {
+      return 0;
+    }
+  }
+
+
+  template<typename T>
+  consteval static bool Implements_IECS_System()
+  {
+    return std::is_base_of<IECS_System, T>::value;
+  }
+
+  template<typename T>
+  static void DelayedSystemUpdate(void* _systemPtr, ECS_PoolManager* _PoolManager, float _deltaTime)
+  {
+    reinterpret_cast<T*>(_systemPtr)->Update(_PoolManager, _deltaTime);
+  }
+
+  template<typename T>
+  static void DelayedSystemDeleter(void* _systemPtr)
+  {
+    delete reinterpret_cast<T*>(_systemPtr);
+  }
+
+
   // IECS types without specific implementation.
   template<typename T>
   consteval static bool Implements_IECS_Transform()
@@ -0,0 +1,127 @@
+#include "ECS_SystemScheduler.h"
+
+ECS_SystemScheduler::~ECS_SystemScheduler()
+{
+	for (Phase& phase : m_phases)
+	{
+		for (SystemEntry& system : phase.m_systems)
+		{
+			system.m_delayedDeleterFunct(system.m_pSystem);
+		}
+	}
+}
+
+void ECS_SystemScheduler::RunSystems(ECS_SystemPhase _phase, ECS_PoolManager* _PoolManager, float _deltaTime)
+{
+	Phase& phase = GetPhase(_phase);
+	const unsigned int numberOfSystems = static_cast<unsigned int>(phase.m_systems.size());
+
+	if (numberOfSystems == 0)
+	{
+		return;
+	}
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+
+	// Without worker threads, running the Systems in registration order already respects every dependency.
+	if (jobSystem == nullptr || jobSystem->GetNumberOfThreads() <= 1 || numberOfSystems == 1)
+	{
+		for (SystemEntry& system : phase.m_systems)
+		{
+			system.m_delayedUpdateFunct(system.m_pSystem, _PoolManager, _deltaTime);
+		}
+		return;
+	}
+
+	if (phase.m_dependenciesOutdated)
+	{
+		BuildDependencies(phase);
+	}
+
+	// Building this frame's graph. Every System Job is a child of the root, so waiting for the root waits for all of them.
+	Job* root = jobSystem->CreateJob(static_cast<JobFunction>([](Job*, void*) {}));
+
+	for (unsigned int i = 0; i < numberOfSystems; i++)
+	{
+		phase.m_pendingDependencies[i].store(phase.m_systems[i].m_uNumberOfDependencies, std::memory_order_relaxed);
+		phase.m_frameJobs[i] = jobSystem->CreateJob([this, &phase, i, _PoolManager, _deltaTime]()
+			{
+				ExecuteSystem(phase, i, _PoolManager, _deltaTime);
+			}, root);
+	}
+
+	for (unsigned int i = 0; i < numberOfSystems; i++)
+	{
+		if (phase.m_systems[i].m_uNumberOfDependencies == 0)
+		{
+			jobSystem->Run(phase.m_frameJobs[i]);
+		}
+	}
+
+	jobSystem->Wait(jobSystem->Run(root));
+}
+
+bool ECS_SystemScheduler::DoSystemsConflict(const SystemEntry& _first, const SystemEntry& _second)
+{
+	return _first.m_writeMask.Intersects(_second.m_readMask)
+		|| _first.m_writeMask.Intersects(_second.m_writeMask)
+		|| _second.m_writeMask.Intersects(_first.m_readMask);
+}
+
+void ECS_SystemScheduler::BuildDependencies(Phase& _phase)
+{
+	const unsigned int numberOfSystems = static_cast<unsigned int>(_phase.m_systems.size());
+
+	for (SystemEntry& system : _phase.m_systems)
+	{
+		system.m_dependents.clear();
+		system.m_uNumberOfDependencies = 0;
+	}
+
+	// For every System, the earlier Systems it already waits for through other dependencies.
+	std::vector<std::vector<bool>> ancestors(numberOfSystems, std::vector<bool>(numberOfSystems, false));
+
+	for (unsigned int i = 0; i < numberOfSystems; i++)
+	{
+		// Walking backwards, so the closest conflicting System is found first and makes the older ones redundant.
+		for (unsigned int j = i; j-- > 0;)
+		{
+			if (ancestors[i][j] || !DoSystemsConflict(_phase.m_systems[i], _phase.m_systems[j]))
+			{
+				continue;
+			}
+
+			_phase.m_systems[j].m_dependents.push_back(i);
+			_phase.m_systems[i].m_uNumberOfDependencies++;
+
+			ancestors[i][j] = true;
+			for (unsigned int k = 0; k < j; k++)
+			{
+				if (ancestors[j][k])
+				{
+					ancestors[i][k] = true;
+				}
+			}
+		}
+	}
+
+	_phase.m_frameJobs.assign(numberOfSystems, nullptr);
+	_phase.m_pendingDependencies = std::make_unique<std::atomic<unsigned int>[]>(numberOfSystems);
+	_phase.m_dependenciesOutdated = false;
+}
+
+void ECS_SystemScheduler::ExecuteSystem(Phase& _phase, unsigned int _uSystemIndex, ECS_PoolManager* _PoolManager, float _deltaTime)
+{
+	SystemEntry& system = _phase.m_systems[_uSystemIndex];
+	system.m_delayedUpdateFunct(system.m_pSystem, _PoolManager, _deltaTime);
+
+	// Releasing the Systems that were waiting for this one.
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	for (unsigned int dependent : system.m_dependents)
+	{
+		if (_phase.m_pendingDependencies[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			jobSystem->Run(_phase.m_frameJobs[dependent]);
+		}
+	}
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "ECS_Typedefs.h"
+#include "ECS_SupportingFunctions.h"
+#include "Engine/Jobs/JobSystem.h"
+#include <assert.h>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// List of Component types, used by Systems to declare which Components they read and which ones they write.
+/// </summary>
+template<typename... Components>
+struct ECS_ComponentList
+{
+	static PoolComponentMask GetMask()
+	{
+		PoolComponentMask mask;
+		if constexpr (sizeof...(Components) > 0)
+		{
+			ECS::SetPoolComponentMask<Components...>(mask);
+		}
+		return mask;
+	}
+};
+
+enum class ECS_SystemPhase : unsigned char
+{
+	Physics,
+	Collision, // After the collision pipeline of the step, so its Systems can read the contacts.
+	Logic,
+
+	COUNT
+};
+
+/// <summary>
+/// Runs the registered Systems of a phase, in parallel when the JobSystem is available.
+/// <para>Two Systems conflict when one of them writes a Component that the other one reads or writes.
+/// Conflicting Systems always run in registration order, while the rest can run at the same time, so the result is deterministic.</para>
+/// </summary>
+class ECS_SystemScheduler
+{
+	struct SystemEntry
+	{
+		void* m_pSystem{ nullptr };
+		delayed_funct_system_update m_delayedUpdateFunct{ nullptr };
+		delayed_destructor_func m_delayedDeleterFunct{ nullptr };
+
+		PoolComponentMask m_readMask;
+		PoolComponentMask m_writeMask;
+
+		// Edges of the dependency graph. Only the ones that are not implied by other edges are stored.
+		std::vector<unsigned int> m_dependents;
+		unsigned int m_uNumberOfDependencies{ 0 };
+	};
+
+	struct Phase
+	{
+		std::vector<SystemEntry> m_systems;
+		bool m_dependenciesOutdated{ false };
+
+		// Per-frame state.
+		std::vector<Job*> m_frameJobs;
+		std::unique_ptr<std::atomic<unsigned int>[]> m_pendingDependencies;
+	};
+
+	Phase m_phases[static_cast<unsigned int>(ECS_SystemPhase::COUNT)];
+
+public:
+	ECS_SystemScheduler() {};
+	ECS_SystemScheduler(const ECS_SystemScheduler&) = delete;
+	ECS_SystemScheduler& operator=(const ECS_SystemScheduler&) = delete;
+	~ECS_SystemScheduler();
+
+	/// <summary>
+	/// Creates a System and adds it at the end of the given phase. The scheduler owns the System.
+	/// </summary>
+	template<typename System, typename... ConstructorArgs>
+	System* RegisterSystem(ECS_SystemPhase _phase, ConstructorArgs&&... _constructorArgs)
+	{
+		static_assert(ECS_INTERNAL::Implements_IECS_System<System>(), "Trying to register a System that doesn't implement IECS_System.");
+
+		System* newSystem = new System(std::forward<ConstructorArgs>(_constructorArgs)...);
+
+		SystemEntry entry;
+		entry.m_pSystem = newSystem;
+		entry.m_delayedUpdateFunct = &ECS_INTERNAL::DelayedSystemUpdate<System>;
+		entry.m_delayedDeleterFunct = &ECS_INTERNAL::DelayedSystemDeleter<System>;
+		entry.m_readMask = System::Reads::GetMask();
+		entry.m_writeMask = System::Writes::GetMask();
+
+		Phase& phase = GetPhase(_phase);
+		phase.m_systems.push_back(std::move(entry));
+		phase.m_dependenciesOutdated = true;
+
+		return newSystem;
+	}
+
+	void RunSystems(ECS_SystemPhase _phase, ECS_PoolManager* _PoolManager, float _deltaTime);
+
+	inline unsigned int HowManySystems(ECS_SystemPhase _phase) const { return static_cast<unsigned int>(m_phases[static_cast<unsigned int>(_phase)].m_systems.size()); };
+
+private:
+	inline Phase& GetPhase(ECS_SystemPhase _phase)
+	{
+		assert(_phase < ECS_SystemPhase::COUNT && "Trying to access an invalid System phase.");
+		return m_phases[static_cast<unsigned int>(_phase)];
+	}
+
+	static bool DoSystemsConflict(const SystemEntry& _first, const SystemEntry& _second);
+	void BuildDependencies(Phase& _phase);
+	void ExecuteSystem(Phase& _phase, unsigned int _uSystemIndex, ECS_PoolManager* _PoolManager, float _deltaTime);
+};
@@ -6,4 +6,8 @@ class ECS_Pool_Initializer
 {
 public:
 	virtual void InitializeECSPools(ECS_PoolManager* _PoolManager) = 0;
+	// Called before any System or Component can publish. Every event type used by the game must be registered here.
+	virtual void InitializeEvents(EventBus* /*_EventBus*/) {};
+	// Called after all Pools have been created. Systems registered here run after the Engine ones of the same phase.
+	virtual void InitializeECSSystems(ECS_PoolManager* /*_PoolManager*/) {};
 };
\ No newline at end of file
@@ -1,10 +1,9 @@
 #include "Engine.h"
 #include "Engine/ECS_Pools_Init_Base.h"
-#include "Engine/Components/Rigidbody/C_RigidBody2D.h"
-#include "Engine/Components/Collision/C_Collider2D.h"
-#include "Game/Components/C_BallController.h"
-#include "Game/Components/C_PlayerController.h"
+#include "Engine/Systems/S_RigidbodyIntegration.h"
+#include "Engine/Systems/S_WorldBounds.h"
 #include "ExternalLibraries/Tigr/tigr.h"
+#include <cmath>
 
 
 #pragma region ENGINE CONTROLS
@@ -25,9 +24,55 @@ bool Engine::Init(ECS_Pool_Initializer* _PoolInitializerClass)
 	}
 
 	m_isRunning = true;
+
+	m_frameLimiter.Init(FPS_LimitMode, FPS_Target);
+
+	unsigned int numberOfWorkers = 0;
+	if constexpr (NumberOfWorkerThreads < 0)
+	{
+		const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+		numberOfWorkers = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+	else
+	{
+		numberOfWorkers = NumberOfWorkerThreads;
+	}
+	m_pJobSystem = JobSystem::InitJobSystem(numberOfWorkers);
+
+	if constexpr (PipelinedRendering)
+	{
+		m_pRenderTarget = tigrBitmap(m_pScreen->w, m_pScreen->h);
+		RenderQueue::SetDeferTextureReleases(true);
+	}
+
 	m_pPoolManager = ECS_PoolManager::InitManager();
 
+	// A tick per simulation step, so timers fire in the step they expire.
+	m_pTimerWheel = new TimerWheel();
+	m_pTimerWheel->SetTickDuration(FixedStepsPerSecond > 0 ? FixedDeltaTime : 1.0f / FPS_Target);
+
+	m_pCollisionPipeline = new CollisionPipeline2D();
+
+	// All Pools are registered in a single transaction, so the Pool Information files are written once at most.
+	m_pPoolManager->BeginPoolRegistration();
 	_PoolInitializerClass->InitializeECSPools(m_pPoolManager);
+	m_pPoolManager->CommitPoolRegistration();
+
+	_PoolInitializerClass->InitializeEvents(m_pPoolManager->GetEventBus());
+
+	// Engine Systems are registered first, so Game Systems that conflict with them run after them.
+	m_pPoolManager->RegisterSystem<S_RigidbodyIntegration>(ECS_SystemPhase::Physics);
+	// After the collision pipeline, which sweeps the bodies along the movement of the integration.
+	// Its long steps are swept back from the position minus a whole step of velocity, so nothing may change the position or the velocity
+	// of a bounded Entity between the integration and it: no Physics System registered after the integration, nor Collision System before it.
+	m_pPoolManager->RegisterSystem<S_WorldBounds>(ECS_SystemPhase::Collision, AABB2D{ vec2(0, 0), vec2(static_cast<float>(m_pScreen->w), static_cast<float>(m_pScreen->h)) });
+	_PoolInitializerClass->InitializeECSSystems(m_pPoolManager);
+
+	if constexpr (RECORD_POOL_CAPACITIES)
+	{
+		m_pPoolManager->StartPoolCapacityRecording();
+	}
+
 	Instance = this;
 
 	return true;
@@ -43,8 +88,7 @@ bool Engine::UpdateTigrScreen()
 }
 bool Engine::UpdateDeltaTime()
 {
-	unscaledDeltaTime = tigrTime() + m_additionalTimeSpentAfterFrame;
-	m_additionalTimeSpentAfterFrame = 0;
+	unscaledDeltaTime = static_cast<float>(m_frameLimiter.BeginFrame());
 
 	// We ensure that deltaTime will never be 0.
 	if (unscaledDeltaTime <= 0)
@@ -54,75 +98,69 @@ bool Engine::UpdateDeltaTime()
 
 	deltaTime = unscaledDeltaTime * m_timeScale;
 
+	if constexpr (FixedStepsPerSecond > 0)
+	{
+		m_fixedStepAccumulator += deltaTime;
+		deltaTime = FixedDeltaTime;
+	}
+
+	m_pPoolManager->UpdatePoolCapacityRecording(unscaledDeltaTime);
+
 	return true;
 }
 float Engine::CalculateUnscaledDeltaTimeSinceBeginningOfFrame()
 {
-	m_additionalTimeSpentAfterFrame += tigrTime();
-	return m_additionalTimeSpentAfterFrame;
+	return static_cast<float>(m_frameLimiter.GetTimeSinceBeginningOfFrame());
 }
-void Engine::UpdatePhysics()
+bool Engine::StepSimulation()
 {
-	// Rigidbody Physics
+	if constexpr (FixedStepsPerSecond > 0)
 	{
-		ECS_PoolManager::Iterator iteratorEnd = m_pPoolManager->EndIterator<C_Transform2D, C_Rigidbody2D>();
-		for (ECS_PoolManager::Iterator it = m_pPoolManager->BeginIterator<C_Transform2D, C_Rigidbody2D>(); it != iteratorEnd; ++it)
+		if (m_fixedStepAccumulator >= FixedDeltaTime && m_uStepsThisFrame < MaxFixedStepsPerFrame)
 		{
-			it.GetComponent<C_Rigidbody2D>()->UpdatePhysics(*it.GetComponent<C_Transform2D>(), GetDeltaTime());
+			m_fixedStepAccumulator -= FixedDeltaTime;
+			m_uStepsThisFrame++;
+
+			m_pPoolManager->StoreTransformsPreviousState();
+			return true;
 		}
-	}
 
-	// Ball Collisions with the edges of the screen and the Player.
-	{
-		EntityID playerEntityID = ECS::CONSTANTS::InvalidEntityID();
-		C_Collider2D* playerCollider = nullptr;
-		C_Transform2D* playerTransform = nullptr;
-		if (C_PlayerController* playerController = C_PlayerController::GetInstance())
+		// Dropping the steps we couldn't catch up with, so a slow frame doesn't make the next ones even slower.
+		if (m_fixedStepAccumulator >= FixedDeltaTime)
 		{
-			playerEntityID = playerController->GetPlayerEntityID();
-			if (playerEntityID != ECS::CONSTANTS::InvalidEntityID())
-			{
-				playerCollider = m_pPoolManager->GetEntityPool(ECS::GetPoolFromId(playerEntityID))->GetComponent<C_Collider2D>(playerEntityID);
-				playerTransform = m_pPoolManager->GetEntityPool(ECS::GetPoolFromId(playerEntityID))->GetComponent<C_Transform2D>(playerEntityID);
-			}
+			m_fixedStepAccumulator = std::fmod(m_fixedStepAccumulator, FixedDeltaTime);
 		}
 
-		// Iterating all balls.
-		ECS_PoolManager::Iterator ballIteratorEnd = m_pPoolManager->EndIterator<C_Transform2D, C_Collider2D, C_BallController, C_Rigidbody2D>();
-		for (ECS_PoolManager::Iterator ballIt = m_pPoolManager->BeginIterator<C_Transform2D, C_Collider2D, C_BallController, C_Rigidbody2D>(); ballIt != ballIteratorEnd; ++ballIt)
+		m_interpolationAlpha = m_fixedStepAccumulator / FixedDeltaTime;
+	}
+	else
+	{
+		if (m_uStepsThisFrame == 0)
 		{
-			C_Collider2D* ballCollider = ballIt.GetComponent<C_Collider2D>();
-			C_Rigidbody2D* ballRigidbody = ballIt.GetComponent<C_Rigidbody2D>();
+			m_uStepsThisFrame++;
+			return true;
+		}
 
-			// Checking against the edges of the screen.
-			vec2& ballPos = ballIt.GetComponent<C_Transform2D>()->m_pos;
+		m_interpolationAlpha = 1;
+	}
 
-			// Left or Right edges
-			if (ballRigidbody->m_velocity.x < 0 && ballPos.x + ballCollider->m_Offset.x < ballCollider->m_Dimensions.x / 2 
-				|| ballRigidbody->m_velocity.x > 0 && ballPos.x + ballCollider->m_Offset.x >(m_pScreen->w - ballCollider->m_Dimensions.x / 2))
-			{
-				ballRigidbody->m_velocity.x *= -1;
-			}
-			// Up or Down edges
-			if (ballRigidbody->m_velocity.y < 0 && ballPos.y + ballCollider->m_Offset.y < ballCollider->m_Dimensions.y / 2 
-				|| ballRigidbody->m_velocity.y > 0 && ballPos.y + ballCollider->m_Offset.y >(m_pScreen->h - ballCollider->m_Dimensions.y / 2))
-			{
-				ballRigidbody->m_velocity.y *= -1;
-			}
+	m_uStepsThisFrame = 0;
+	return false;
+}
+void Engine::UpdatePhysics()
+{
+	m_pPoolManager->RunSystems(ECS_SystemPhase::Physics, GetDeltaTime());
 
-			// Checking against the player.
-			if (playerCollider != nullptr && playerTransform != nullptr &&
-				ballCollider->CheckOverlap(*ballIt.GetComponent<C_Transform2D>(), *playerCollider, *playerTransform))
-			{
-				C_PlayerController::GetInstance()->TryToEndGame();
-				break;
-			}
-		}
-	}
+	// The bodies have moved, so the contacts are found again before the Systems that react to collisions.
+	m_pCollisionPipeline->Update(m_pPoolManager, GetDeltaTime());
+	m_pPoolManager->RunSystems(ECS_SystemPhase::Collision, GetDeltaTime());
 }
 bool Engine::UpdateLogic()
 {
 	m_pPoolManager->UpdateComponents(GetDeltaTime());
+	m_pPoolManager->UpdateBehaviours(GetDeltaTime());
+	m_pPoolManager->RunSystems(ECS_SystemPhase::Logic, GetDeltaTime());
+	m_pTimerWheel->Advance(GetDeltaTime());
 	return true;
 }
 bool Engine::ClearScreen()
@@ -130,12 +168,103 @@ bool Engine::ClearScreen()
 	tigrClear(m_pScreen, tigrRGB(0, 0, 0));
 	return true;
 }
+void Engine::BuildRenderState()
+{
+	m_pPoolManager->BuildRenderQueue(m_renderQueues[m_uBuildRenderQueueIndex], m_interpolationAlpha);
+}
+bool Engine::FinishRendering()
+{
+	if constexpr (PipelinedRendering)
+	{
+		if (m_renderJob.IsValid())
+		{
+			m_pJobSystem->Wait(m_renderJob);
+			m_renderJob = JobHandle{};
+		}
+
+		// Nothing is drawing now, so the textures released during the simulation can't be referenced anymore.
+		RenderQueue::FlushReleasedTextures();
+
+		tigrBlit(m_pScreen, m_pRenderTarget, 0, 0, 0, 0, m_pRenderTarget->w, m_pRenderTarget->h);
+	}
+	else
+	{
+		ClearScreen();
+		m_renderQueues[m_uBuildRenderQueueIndex].Submit(m_pScreen);
+	}
+
+	return true;
+}
+void Engine::StartRendering()
+{
+	if constexpr (PipelinedRendering)
+	{
+		const RenderQueue* renderState = &m_renderQueues[m_uBuildRenderQueueIndex];
+		Tigr* renderTarget = m_pRenderTarget;
+		m_uBuildRenderQueueIndex ^= 1;
+
+		// The Job goes to the oldest end of the main thread's queue, so a worker steals it
+		// while the main thread keeps popping the Jobs of the next simulation step.
+		m_renderJob = m_pJobSystem->Run(m_pJobSystem->CreateJob([renderState, renderTarget]()
+			{
+				tigrClear(renderTarget, tigrRGB(0, 0, 0));
+				renderState->Submit(renderTarget);
+			}));
+	}
+}
+void Engine::LimitFrameRate()
+{
+	m_frameLimiter.EndFrame();
+}
 bool Engine::Quit()
 {
+	if constexpr (LogFramePacingOnQuit)
+	{
+		const FramePacingStats stats = m_frameLimiter.GetStats();
+		printf("Frame pacing over the last %u frames (target %.1f FPS, %u missed deadlines):\n", stats.m_uNumberOfFrames, stats.m_targetFPS, stats.m_uMissedDeadlines);
+		printf("  Frame time ms : avg %.3f, min %.3f, p50 %.3f, p95 %.3f, p99 %.3f, max %.3f, std dev %.3f\n",
+			stats.m_averageFrameTime * 1000, stats.m_minFrameTime * 1000, stats.m_p50FrameTime * 1000, stats.m_p95FrameTime * 1000,
+			stats.m_p99FrameTime * 1000, stats.m_maxFrameTime * 1000, stats.m_frameTimeStandardDeviation * 1000);
+		printf("  Work time ms : avg %.3f, p95 %.3f\n", stats.m_averageWorkTime * 1000, stats.m_p95WorkTime * 1000);
+	}
+
+	if (m_renderJob.IsValid())
+	{
+		m_pJobSystem->Wait(m_renderJob);
+		m_renderJob = JobHandle{};
+	}
+	if (m_pRenderTarget != nullptr)
+	{
+		tigrFree(m_pRenderTarget);
+		m_pRenderTarget = nullptr;
+	}
+
 	tigrFree(m_pScreen);
 	m_pScreen = nullptr;
 
+	if constexpr (SaveMemoryReportOnQuit)
+	{
+		m_pPoolManager->SaveMemoryReport();
+	}
+	if (m_pPoolManager->IsRecordingPoolCapacities())
+	{
+		m_pPoolManager->StopPoolCapacityRecording();
+	}
+
+	// Pending timers are dropped. They can reference Entities, so the wheel goes before the Pools.
+	delete m_pTimerWheel;
+	m_pTimerWheel = nullptr;
+	delete m_pCollisionPipeline;
+	m_pCollisionPipeline = nullptr;
+
 	ECS_PoolManager::DestroyInstance();
+
+	// Frees the textures of the destroyed Components too.
+	RenderQueue::SetDeferTextureReleases(false);
+
+	JobSystem::DestroyInstance();
+	m_pJobSystem = nullptr;
+
 	Instance = nullptr;
 
 	return true;
@@ -158,15 +287,5 @@ void Engine::Print(const char* text)
 {
 	tigrPrint(m_pScreen, tfont, 0, 0, tigrRGB(0xff, 0xff, 0xff), text);
 }
-void Engine::Wait(float _secs)
-{
-	float timePassed = 0;
-	while ((timePassed += tigrTime()) < _secs)
-	{
-
-	}
-
-	m_additionalTimeSpentAfterFrame += _secs;
-}
 
 #pragma endregion
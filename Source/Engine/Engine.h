@@ -2,6 +2,10 @@
 
 #include "Engine/EngineConfiguration.h"
 #include "Engine/ECS/ECS_PoolManager.h"
+#include "Engine/Jobs/JobSystem.h"
+#include "Engine/Time/FrameLimiter.h"
+#include "Engine/Time/TimerWheel.h"
+#include "Engine/Physics/CollisionPipeline2D.h"
 #include <string>
 #include <sstream>
 
@@ -14,10 +18,29 @@ class Engine
 public:
 	static constexpr float FPS_Target{ CONFIG_FPS_TARGET };
 #undef CONFIG_FPS_TARGET
+	static constexpr FrameLimitMode FPS_LimitMode{ static_cast<FrameLimitMode>(CONFIG_ENGINE_FPS_LIMITED) };
+#undef CONFIG_ENGINE_FPS_LIMITED
+	static constexpr bool LogFramePacingOnQuit{ CONFIG_ENGINE_LOG_FRAME_PACING_ON_QUIT };
+#undef CONFIG_ENGINE_LOG_FRAME_PACING_ON_QUIT
+	static constexpr int FixedStepsPerSecond{ CONFIG_ENGINE_FIXED_STEPS_PER_SECOND };
+#undef CONFIG_ENGINE_FIXED_STEPS_PER_SECOND
+	static constexpr unsigned int MaxFixedStepsPerFrame{ CONFIG_ENGINE_MAX_FIXED_STEPS_PER_FRAME };
+#undef CONFIG_ENGINE_MAX_FIXED_STEPS_PER_FRAME
+	static constexpr float FixedDeltaTime{ FixedStepsPerSecond > 0 ? 1.0f / FixedStepsPerSecond : 0.0f };
+	static constexpr bool SaveMemoryReportOnQuit{ CONFIG_ENGINE_SAVE_MEMORY_REPORT_ON_QUIT };
+#undef CONFIG_ENGINE_SAVE_MEMORY_REPORT_ON_QUIT
+	static constexpr int NumberOfWorkerThreads{ CONFIG_ENGINE_NUMBER_OF_WORKER_THREADS };
+#undef CONFIG_ENGINE_NUMBER_OF_WORKER_THREADS
+	static constexpr bool RunIntegrationBenchmark{ CONFIG_ENGINE_RUN_INTEGRATION_BENCHMARK };
+#undef CONFIG_ENGINE_RUN_INTEGRATION_BENCHMARK
+	static constexpr bool PipelinedRendering{ CONFIG_ENGINE_PIPELINED_RENDERING };
+#undef CONFIG_ENGINE_PIPELINED_RENDERING
 
 	static inline const std::string CONFIGURATION_FILES_PATH{ "Assets/EngineConfigFiles/" };
 	static inline const std::string POOL_FILE_NAME{ "ECS_Pools_Information" };
+	static inline const std::string MEMORY_REPORT_FILE_NAME{ "ECS_Memory_Report" };
 	static inline const std::string XML_FILE_EXTENSION{ ".xml" };
+	static inline const std::string BINARY_FILE_EXTENSION{ ".bin" };
 
 private:
 	static inline Engine* Instance{ nullptr };
@@ -25,13 +48,28 @@ private:
 	bool m_isRunning{ false };
 
 	float m_timeScale{ 1 };
-	float m_additionalTimeSpentAfterFrame{ 0 };
 
 	float deltaTime{ 0 };
 	float unscaledDeltaTime{ 0 };
 
+	// Fixed step
+	float m_fixedStepAccumulator{ 0 };
+	unsigned int m_uStepsThisFrame{ 0 };
+	float m_interpolationAlpha{ 1 };
+
 	Tigr* m_pScreen { nullptr };
 	ECS_PoolManager* m_pPoolManager { nullptr };
+	JobSystem* m_pJobSystem { nullptr };
+
+	// Double-buffered render state. One queue is built from the simulation while the other one is drawn into m_pRenderTarget.
+	RenderQueue m_renderQueues[2];
+	unsigned int m_uBuildRenderQueueIndex{ 0 };
+	Tigr* m_pRenderTarget { nullptr };
+	JobHandle m_renderJob;
+
+	FrameLimiter m_frameLimiter;
+	TimerWheel* m_pTimerWheel { nullptr };
+	CollisionPipeline2D* m_pCollisionPipeline { nullptr };
 
 	// Functions
 
@@ -42,9 +80,32 @@ public:
 	bool UpdateTigrScreen();
 	bool UpdateDeltaTime();
 	float CalculateUnscaledDeltaTimeSinceBeginningOfFrame();
+	/// <summary>
+	/// Returns true while the simulation has to run another step this frame: call UpdatePhysics and UpdateLogic once per step.
+	/// <para>With fixed steps, the time of the frame is consumed in steps of FixedDeltaTime and the leftover sets the interpolation alpha of the rendering.
+	/// Otherwise, there's exactly one step per frame.</para>
+	/// </summary>
+	bool StepSimulation();
 	void UpdatePhysics();
 	bool UpdateLogic();
 	bool ClearScreen();
+	/// <summary>
+	/// Snapshots the render state of the simulation into the queue that is not being drawn.
+	/// </summary>
+	void BuildRenderState();
+	/// <summary>
+	/// Leaves the last drawn frame on the screen, ready for tigrUpdate. Without pipelining, this draws the state that was just built.
+	/// With pipelining, it waits for the frame started by the previous StartRendering, so the screen is always one frame behind the simulation.
+	/// </summary>
+	bool FinishRendering();
+	/// <summary>
+	/// Starts drawing the last built render state on a worker, so it overlaps with the simulation of the next frame. Does nothing without pipelining.
+	/// </summary>
+	void StartRendering();
+	/// <summary>
+	/// Ends the frame, waiting as CONFIG_ENGINE_FPS_LIMITED requires.
+	/// </summary>
+	void LimitFrameRate();
 	bool Quit();
 
 	static inline const Engine* GetInstance() {	return Instance; };
@@ -54,14 +115,32 @@ public:
 #pragma region ENGINE FUNCTIONS
 public:
 	inline ECS_PoolManager* GetPoolManager() const { return m_pPoolManager; };
+	inline JobSystem* GetJobSystem() const { return m_pJobSystem; };
+	/// <summary>
+	/// Delayed callbacks and Entity lifetimes, advanced with the scaled time at the end of every logic step.
+	/// </summary>
+	inline TimerWheel* GetTimerWheel() const { return m_pTimerWheel; };
+	/// <summary>
+	/// Contacts of the current step. Only up to date during the Collision phase and after it.
+	/// </summary>
+	inline CollisionPipeline2D* GetCollisionPipeline() const { return m_pCollisionPipeline; };
 	inline Tigr* GetTigrScreen() const { return m_pScreen; };
+	/// <summary>
+	/// Render state built this frame. What is added to it between BuildRenderState and FinishRendering is drawn with the sprites of the same frame.
+	/// </summary>
+	inline RenderQueue& GetBuildRenderState() { return m_renderQueues[m_uBuildRenderQueueIndex]; };
+	/// <summary>
+	/// Time simulated by the current step. With fixed steps, it's always FixedDeltaTime.
+	/// </summary>
 	inline float GetDeltaTime() const { return deltaTime; };
+	inline float GetUnscaledDeltaTime() const { return unscaledDeltaTime; };
+	inline float GetInterpolationAlpha() const { return m_interpolationAlpha; };
+	inline FramePacingStats GetFramePacingStats() const { return m_frameLimiter.GetStats(); };
 
 	bool ShouldClose();
 	inline void LogMe(const std::string& _text) const { printf("%s\n", _text); };
 	inline void LogMe(const std::string&& _text) const { printf("%s\n", _text); };
 	void Print(const char* text);
-	void Wait(float _secs);
 
 	template<typename T>
 	std::string ToString(const T& _text)
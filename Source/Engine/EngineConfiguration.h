@@ -1,5 +1,20 @@
 #pragma once
 
 // FPS Limitations
-#define CONFIG_ENGINE_FPS_LIMITED 0 // 1 for LIMITED, 0 for NOT LIMITED, -1 ADAPTIVE
+#define CONFIG_ENGINE_FPS_LIMITED 1 // 1 for LIMITED, 0 for NOT LIMITED, -1 ADAPTIVE (FPS_TARGET divided by the smallest integer that fits the 95th percentile frame)
 #define CONFIG_FPS_TARGET 60
+#define CONFIG_ENGINE_LOG_FRAME_PACING_ON_QUIT 1 // Prints the frame time statistics of the last frames when the Engine quits.
+
+// Simulation Step
+#define CONFIG_ENGINE_FIXED_STEPS_PER_SECOND 60 // Physics and Logic run at this fixed rate, and the rendering interpolates between steps. 0 or less steps once per frame with the frame deltaTime.
+#define CONFIG_ENGINE_MAX_FIXED_STEPS_PER_FRAME 5 // When a frame takes longer than this many steps, the remaining time is dropped and the simulation slows down.
+
+// Memory Accounting
+#define CONFIG_ENGINE_SAVE_MEMORY_REPORT_ON_QUIT 1 // Writes ECS_Memory_Report.xml next to the Pool Information file when the Engine quits.
+
+// Job System
+#define CONFIG_ENGINE_NUMBER_OF_WORKER_THREADS -1 // -1 uses one worker per hardware thread, minus the main thread. 0 runs every Job on the main thread.
+#define CONFIG_ENGINE_RUN_INTEGRATION_BENCHMARK 0 // 1 makes Main print how the rigidbody integration scales with the number of bodies and workers, and quit without opening the game.
+
+// Rendering
+#define CONFIG_ENGINE_PIPELINED_RENDERING 1 // 1 draws each frame on a worker while the next one is simulated, adding one frame of latency. 0 draws on the main thread right after simulating.
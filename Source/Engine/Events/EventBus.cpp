@@ -0,0 +1,12 @@
+#include "EventBus.h"
+
+EventBus::~EventBus()
+{
+	for (Channel& channel : m_channels)
+	{
+		if (channel.m_pQueue != nullptr)
+		{
+			channel.m_deleterFunct(channel.m_pQueue);
+		}
+	}
+}
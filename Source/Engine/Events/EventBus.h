@@ -0,0 +1,143 @@
+#pragma once
+
+#include "MPSCQueue.h"
+#include <assert.h>
+#include <atomic>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// Typed messaging between Systems and Components. Every event type has its own lock-free queue, so any thread can Publish
+/// while a single consumer Drains the events in batches, at a point of the frame it chooses.
+/// <para>Producers never call into the consumers, so they don't need to write the consumers' Components.
+/// Event types are registered once before the simulation starts, like the Pools.</para>
+/// </summary>
+class EventBus
+{
+public:
+	static constexpr unsigned int DEFAULT_EVENT_CAPACITY{ 1024 };
+
+private:
+	typedef void (*channel_deleter_func)(void*);
+
+	struct Channel
+	{
+		void* m_pQueue{ nullptr };
+		channel_deleter_func m_deleterFunct{ nullptr };
+	};
+
+	std::vector<Channel> m_channels;
+
+	static inline std::atomic<unsigned int> NextEventTypeId{ 0 };
+
+public:
+	EventBus() {};
+	EventBus(const EventBus&) = delete;
+	EventBus& operator=(const EventBus&) = delete;
+	~EventBus();
+
+	/// <summary>
+	/// Creates the queue of an event type. _uCapacity is rounded up to a power of two.
+	/// Not thread-safe: call it during initialization, before anyone publishes.
+	/// </summary>
+	template<typename Event>
+	void RegisterEvent(unsigned int _uCapacity = DEFAULT_EVENT_CAPACITY);
+
+	template<typename Event>
+	inline bool IsEventRegistered() const
+		{ return GetEventTypeId<Event>() < m_channels.size() && m_channels[GetEventTypeId<Event>()].m_pQueue != nullptr; };
+
+	/// <summary>
+	/// Any thread. Returns false, and the event is lost, if the queue of the event type is full.
+	/// </summary>
+	template<typename Event>
+	bool Publish(const Event& _event);
+
+	/// <summary>
+	/// Consumer only. Calls _function(const Event&) for the events published so far, in the order their producers claimed them,
+	/// and returns how many there were. Events published from inside _function are left for the next Drain.
+	/// </summary>
+	template<typename Event, typename Function>
+	unsigned int Drain(Function&& _function);
+
+private:
+	template<typename Event>
+	static unsigned int GetEventTypeId()
+	{
+		static const unsigned int eventTypeId = NextEventTypeId.fetch_add(1, std::memory_order_relaxed);
+		return eventTypeId;
+	}
+
+	template<typename Event>
+	inline MPSCQueue<Event>* GetQueue() const
+	{
+		assert(IsEventRegistered<Event>() && "Trying to use an event type that was not registered in the EventBus.");
+		return static_cast<MPSCQueue<Event>*>(m_channels[GetEventTypeId<Event>()].m_pQueue);
+	}
+};
+
+#pragma region Template Implementations
+
+template<typename Event>
+void EventBus::RegisterEvent(unsigned int _uCapacity)
+{
+	static_assert(std::is_default_constructible_v<Event> && std::is_copy_assignable_v<Event>, "Events are copied into preallocated queues, so they must be default constructible and copy assignable.");
+
+	if (IsEventRegistered<Event>())
+	{
+		assert(false && "Trying to register an event type twice in the EventBus.");
+		return;
+	}
+
+	const unsigned int eventTypeId = GetEventTypeId<Event>();
+	if (eventTypeId >= m_channels.size())
+	{
+		m_channels.resize(eventTypeId + 1);
+	}
+
+	unsigned int capacity = 2;
+	while (capacity < _uCapacity)
+	{
+		capacity <<= 1;
+	}
+
+	MPSCQueue<Event>* queue = new MPSCQueue<Event>();
+	queue->Init(capacity);
+
+	m_channels[eventTypeId].m_pQueue = queue;
+	m_channels[eventTypeId].m_deleterFunct = [](void* _pQueue) { delete static_cast<MPSCQueue<Event>*>(_pQueue); };
+}
+
+template<typename Event>
+bool EventBus::Publish(const Event& _event)
+{
+	if (!GetQueue<Event>()->Push(_event))
+	{
+		assert(false && "An EventBus queue is full, so the event was lost. Increase the capacity of the event type or drain it more often.");
+		return false;
+	}
+
+	return true;
+}
+
+template<typename Event, typename Function>
+unsigned int EventBus::Drain(Function&& _function)
+{
+	MPSCQueue<Event>* queue = GetQueue<Event>();
+
+	// Only the events claimed before starting, so events published by _function wait for the next Drain.
+	const size_t maxEvents = queue->GetPendingCount();
+	unsigned int drainedEvents = 0;
+
+	Event event;
+	while (drainedEvents < maxEvents && queue->Pop(event))
+	{
+		_function(static_cast<const Event&>(event));
+		drainedEvents++;
+	}
+
+	return drainedEvents;
+}
+
+#pragma endregion
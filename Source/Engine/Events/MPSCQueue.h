@@ -0,0 +1,113 @@
+#pragma once
+
+#include <assert.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/// <summary>
+/// Fixed-size lock-free queue for many producers and a single consumer.
+/// <para>Every cell stores a sequence number that tells whose turn it is: producers claim a position with a CAS and publish the cell by bumping
+/// its sequence, and the consumer frees it by bumping it a full turn ahead. Based on Dmitry Vyukov's bounded MPMC queue, without the consumer CAS.</para>
+/// </summary>
+template<typename T>
+class MPSCQueue
+{
+	struct Cell
+	{
+		std::atomic<size_t> m_sequence{ 0 };
+		T m_value{};
+	};
+
+	std::unique_ptr<Cell[]> m_cells;
+	size_t m_uMask{ 0 };
+
+	// The producers' position is on its own cache line, since it's contended by every producer while the consumer only touches its own.
+	alignas(64) std::atomic<size_t> m_enqueuePosition{ 0 };
+	alignas(64) size_t m_uDequeuePosition{ 0 };
+
+public:
+	MPSCQueue() {};
+	MPSCQueue(const MPSCQueue&) = delete;
+	MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+	/// <summary>
+	/// Allocates the cells. _uCapacity must be a power of two. Not thread-safe.
+	/// </summary>
+	void Init(size_t _uCapacity)
+	{
+		assert(_uCapacity > 1 && (_uCapacity & (_uCapacity - 1)) == 0 && "The capacity of a MPSCQueue must be a power of two.");
+
+		m_cells = std::make_unique<Cell[]>(_uCapacity);
+		m_uMask = _uCapacity - 1;
+		for (size_t i = 0; i < _uCapacity; i++)
+		{
+			m_cells[i].m_sequence.store(i, std::memory_order_relaxed);
+		}
+		m_enqueuePosition.store(0, std::memory_order_relaxed);
+		m_uDequeuePosition = 0;
+	}
+
+	inline size_t GetCapacity() const { return m_uMask + 1; };
+	/// <summary>
+	/// Consumer thread only. Elements claimed by the producers and not popped yet, including the ones still being written.
+	/// </summary>
+	inline size_t GetPendingCount() const { return m_enqueuePosition.load(std::memory_order_acquire) - m_uDequeuePosition; };
+
+	/// <summary>
+	/// Any thread. Returns false if the queue is full.
+	/// </summary>
+	bool Push(const T& _value)
+	{
+		size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			Cell& cell = m_cells[position & m_uMask];
+			const size_t sequence = cell.m_sequence.load(std::memory_order_acquire);
+			const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+			if (difference == 0)
+			{
+				// The cell is free for this position. Claiming it.
+				if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					cell.m_value = _value;
+					cell.m_sequence.store(position + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (difference < 0)
+			{
+				// The consumer hasn't freed the cell of the previous turn yet.
+				return false;
+			}
+			else
+			{
+				// Another producer claimed the position first.
+				position = m_enqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/// <summary>
+	/// Consumer thread only. Returns false if the queue is empty, or if the oldest claimed cell is still being written.
+	/// </summary>
+	bool Pop(T& _value)
+	{
+		Cell& cell = m_cells[m_uDequeuePosition & m_uMask];
+
+		if (cell.m_sequence.load(std::memory_order_acquire) != m_uDequeuePosition + 1)
+		{
+			return false;
+		}
+
+		_value = std::move(cell.m_value);
+		cell.m_sequence.store(m_uDequeuePosition + m_uMask + 1, std::memory_order_release);
+		m_uDequeuePosition++;
+
+		return true;
+	}
+};
@@ -0,0 +1,303 @@
+#include "JobSystem.h"
+#include <assert.h>
+
+namespace
+{
+	constexpr unsigned int InvalidThreadIndex{ static_cast<unsigned int>(-1) };
+
+	// Index of the calling thread inside the JobSystem.
+	thread_local unsigned int CurrentThreadIndex{ InvalidThreadIndex };
+
+	// Xorshift, only used to pick which thread to steal from.
+	inline uint32_t NextRandom(uint32_t& _state)
+	{
+		_state ^= _state << 13;
+		_state ^= _state >> 17;
+		_state ^= _state << 5;
+		return _state;
+	}
+
+	class SpinLockGuard
+	{
+		std::atomic_flag& m_flag;
+
+	public:
+		explicit SpinLockGuard(std::atomic_flag& _flag) : m_flag(_flag)
+		{
+			while (m_flag.test_and_set(std::memory_order_acquire))
+			{
+				std::this_thread::yield();
+			}
+		}
+		~SpinLockGuard() { m_flag.clear(std::memory_order_release); }
+	};
+}
+
+#pragma region Job System General Methods
+
+JobSystem* JobSystem::InitJobSystem(unsigned int _uNumberOfWorkers)
+{
+	assert(Instance == nullptr && "Trying to create a JobSystem when a previous instance of it is still running.");
+
+	Instance = new JobSystem();
+	Instance->m_uNumberOfThreads = _uNumberOfWorkers + 1;
+	Instance->m_threadData = std::make_unique<ThreadData[]>(Instance->m_uNumberOfThreads);
+
+	for (unsigned int i = 0; i < Instance->m_uNumberOfThreads; i++)
+	{
+		Instance->m_threadData[i].m_jobs = std::make_unique<Job[]>(MAX_JOBS_PER_THREAD);
+		Instance->m_threadData[i].m_randomState = 0x9E3779B9u * (i + 1);
+	}
+
+	CurrentThreadIndex = 0;
+
+	Instance->m_workers.reserve(_uNumberOfWorkers);
+	for (unsigned int i = 1; i < Instance->m_uNumberOfThreads; i++)
+	{
+		Instance->m_workers.emplace_back(&JobSystem::WorkerThreadLoop, Instance, i);
+	}
+
+	return Instance;
+}
+
+void JobSystem::DestroyInstance()
+{
+	if (Instance == nullptr)
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(Instance->m_sleepMutex);
+		Instance->m_isShuttingDown.store(true);
+	}
+	Instance->m_sleepCondition.notify_all();
+
+	for (std::thread& worker : Instance->m_workers)
+	{
+		worker.join();
+	}
+
+	CurrentThreadIndex = InvalidThreadIndex;
+
+	delete Instance;
+	Instance = nullptr;
+}
+
+unsigned int JobSystem::GetCurrentThreadIndex() const
+{
+	assert(CurrentThreadIndex < m_uNumberOfThreads && "The JobSystem is being used from a thread that doesn't belong to it.");
+	return CurrentThreadIndex;
+}
+
+#pragma endregion
+
+#pragma region Jobs
+
+Job* JobSystem::CreateJob(JobFunction _function, Job* _pParent)
+{
+	Job* job = AllocateJob();
+
+	job->m_function = _function;
+	job->m_pParent = _pParent;
+	job->m_unfinishedJobs.store(1, std::memory_order_relaxed);
+	job->m_pendingDependencies.store(1, std::memory_order_relaxed);
+	job->m_continuationsClosed = false;
+	job->m_uNumberOfContinuations = 0;
+
+	if (_pParent != nullptr)
+	{
+		_pParent->m_unfinishedJobs.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	return job;
+}
+
+void JobSystem::AddDependency(Job* _dependent, Job* _dependency)
+{
+	_dependent->m_pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+
+	bool tooManyContinuations = false;
+	{
+		SpinLockGuard lock(_dependency->m_continuationsLock);
+
+		if (!_dependency->m_continuationsClosed)
+		{
+			if (_dependency->m_uNumberOfContinuations < Job::MAX_CONTINUATIONS)
+			{
+				_dependency->m_continuations[_dependency->m_uNumberOfContinuations++] = _dependent;
+				return;
+			}
+
+			tooManyContinuations = true;
+		}
+	}
+
+	if (tooManyContinuations)
+	{
+		assert(false && "Trying to add more continuations to a Job than Job::MAX_CONTINUATIONS. The dependency will be resolved by waiting for it.");
+		Wait(GetHandle(_dependency));
+	}
+
+	// The dependency is already finished. _dependent has not been Run yet, so this can't release it.
+	_dependent->m_pendingDependencies.fetch_sub(1, std::memory_order_relaxed);
+}
+
+JobHandle JobSystem::Run(Job* _pJob)
+{
+	const JobHandle handle = GetHandle(_pJob);
+	ReleaseDependency(_pJob);
+	return handle;
+}
+
+bool JobSystem::IsFinished(const JobHandle& _Handle)
+{
+	if (_Handle.m_pJob == nullptr || _Handle.m_pJob->m_generation.load(std::memory_order_acquire) != _Handle.m_generation)
+	{
+		return true;
+	}
+
+	return _Handle.m_pJob->m_unfinishedJobs.load(std::memory_order_acquire) == 0;
+}
+
+void JobSystem::Wait(const JobHandle& _Handle)
+{
+	while (!IsFinished(_Handle))
+	{
+		if (Job* job = GetJob())
+		{
+			Execute(job);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+Job* JobSystem::AllocateJob()
+{
+	ThreadData& threadData = m_threadData[GetCurrentThreadIndex()];
+	Job* job = &threadData.m_jobs[threadData.m_uAllocatedJobs++ & (MAX_JOBS_PER_THREAD - 1)];
+
+	assert(job->m_unfinishedJobs.load(std::memory_order_acquire) == 0 && "Recycling a Job that is not finished. Increase JobSystem::MAX_JOBS_PER_THREAD or wait for Jobs more often.");
+
+	job->m_generation.fetch_add(1, std::memory_order_release);
+
+	return job;
+}
+
+void JobSystem::Execute(Job* _pJob)
+{
+	_pJob->m_function(_pJob, _pJob->m_data);
+	Finish(_pJob);
+}
+
+void JobSystem::Finish(Job* _pJob)
+{
+	if (_pJob->m_unfinishedJobs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+	{
+		return;
+	}
+
+	// Copying the continuations out, since the Job can be recycled as soon as its parent is finished.
+	Job* continuations[Job::MAX_CONTINUATIONS];
+	unsigned int numberOfContinuations = 0;
+	{
+		SpinLockGuard lock(_pJob->m_continuationsLock);
+		_pJob->m_continuationsClosed = true;
+		numberOfContinuations = _pJob->m_uNumberOfContinuations;
+		std::copy_n(_pJob->m_continuations, numberOfContinuations, continuations);
+	}
+
+	Job* parent = _pJob->m_pParent;
+
+	for (unsigned int i = 0; i < numberOfContinuations; i++)
+	{
+		ReleaseDependency(continuations[i]);
+	}
+
+	if (parent != nullptr)
+	{
+		Finish(parent);
+	}
+}
+
+void JobSystem::ReleaseDependency(Job* _pJob)
+{
+	if (_pJob->m_pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		PushJob(_pJob);
+	}
+}
+
+void JobSystem::PushJob(Job* _pJob)
+{
+	if (!m_threadData[GetCurrentThreadIndex()].m_queue.Push(_pJob))
+	{
+		// The queue is full, so there's already plenty of work for everyone.
+		Execute(_pJob);
+		return;
+	}
+
+	m_queuedJobs.fetch_add(1);
+
+	if (m_sleepingWorkers.load() > 0)
+	{
+		// Taking the lock makes sure that a worker that is about to sleep sees the new Job before waiting.
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+		}
+		m_sleepCondition.notify_one();
+	}
+}
+
+Job* JobSystem::GetJob()
+{
+	const unsigned int threadIndex = GetCurrentThreadIndex();
+	ThreadData& threadData = m_threadData[threadIndex];
+
+	Job* job = threadData.m_queue.Pop();
+
+	if (job == nullptr && m_uNumberOfThreads > 1)
+	{
+		// Stealing from the other threads, starting from a random one so all thieves don't target the same queue.
+		const unsigned int firstVictim = NextRandom(threadData.m_randomState) % m_uNumberOfThreads;
+		for (unsigned int i = 0; i < m_uNumberOfThreads && job == nullptr; i++)
+		{
+			const unsigned int victim = (firstVictim + i) % m_uNumberOfThreads;
+			if (victim != threadIndex)
+			{
+				job = m_threadData[victim].m_queue.Steal();
+			}
+		}
+	}
+
+	if (job != nullptr)
+	{
+		m_queuedJobs.fetch_sub(1);
+	}
+
+	return job;
+}
+
+void JobSystem::WorkerThreadLoop(unsigned int _uThreadIndex)
+{
+	CurrentThreadIndex = _uThreadIndex;
+
+	while (!m_isShuttingDown.load(std::memory_order_relaxed))
+	{
+		if (Job* job = GetJob())
+		{
+			Execute(job);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_sleepingWorkers.fetch_add(1);
+		m_sleepCondition.wait(lock, [this]() { return m_queuedJobs.load() > 0 || m_isShuttingDown.load(); });
+		m_sleepingWorkers.fetch_sub(1);
+	}
+}
+
+#pragma endregion
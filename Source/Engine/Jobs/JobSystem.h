@@ -0,0 +1,228 @@
+#pragma once
+
+#include "WorkStealingQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+struct Job;
+
+typedef void (*JobFunction)(Job* _pJob, void* _pData);
+
+/// <summary>
+/// Unit of work executed by the JobSystem.
+/// <para>Jobs are allocated from a ring buffer owned by the thread that creates them, so a Job is recycled after
+/// JobSystem::MAX_JOBS_PER_THREAD further allocations on that thread. Never keep a Job* around for longer than a frame; use a JobHandle instead.</para>
+/// </summary>
+struct alignas(64) Job
+{
+	static constexpr unsigned int MAX_CONTINUATIONS{ 16 };
+	static constexpr unsigned int DATA_SIZE{ 88 };
+
+	JobFunction m_function{ nullptr };
+	Job* m_pParent{ nullptr };
+
+	std::atomic<uint32_t> m_generation{ 0 };
+	// This Job plus its unfinished children. The Job is finished when it reaches 0.
+	std::atomic<int32_t> m_unfinishedJobs{ 0 };
+	// Unfinished dependencies plus one, which is released by JobSystem::Run.
+	std::atomic<int32_t> m_pendingDependencies{ 0 };
+
+	// Jobs that depend on this one.
+	std::atomic_flag m_continuationsLock = ATOMIC_FLAG_INIT;
+	bool m_continuationsClosed{ false };
+	uint16_t m_uNumberOfContinuations{ 0 };
+	Job* m_continuations[MAX_CONTINUATIONS]{};
+
+	alignas(16) unsigned char m_data[DATA_SIZE]{};
+};
+
+/// <summary>
+/// Weak reference to a Job. It stays valid after the Job has been recycled, in which case the Job is reported as finished.
+/// </summary>
+struct JobHandle
+{
+	Job* m_pJob{ nullptr };
+	uint32_t m_generation{ 0 };
+
+	inline bool IsValid() const { return m_pJob != nullptr; };
+};
+
+/// <summary>
+/// Work-stealing thread pool. Every thread (the main thread plus the workers) owns a Chase-Lev deque: it pushes and pops
+/// its own Jobs from one end while idle threads steal from the other.
+/// <para>Only depends on the standard library, so ECS code can use it without including the rest of the Engine.</para>
+/// <para>All the methods must be called from the thread that initialized the JobSystem or from inside a Job.</para>
+/// </summary>
+class JobSystem
+{
+public:
+	static constexpr unsigned int MAX_JOBS_PER_THREAD{ 4096 };
+	static_assert((MAX_JOBS_PER_THREAD & (MAX_JOBS_PER_THREAD - 1)) == 0, "MAX_JOBS_PER_THREAD must be a power of two.");
+
+	// ParallelFor never splits a range in more chunks than this, no matter how small the grain size is.
+	static constexpr unsigned int MAX_PARALLEL_FOR_CHUNKS{ 1024 };
+
+private:
+	struct alignas(64) ThreadData
+	{
+		WorkStealingQueue m_queue;
+		std::unique_ptr<Job[]> m_jobs;
+		unsigned int m_uAllocatedJobs{ 0 };
+		uint32_t m_randomState{ 0 };
+	};
+
+	std::unique_ptr<ThreadData[]> m_threadData;
+	std::vector<std::thread> m_workers;
+	unsigned int m_uNumberOfThreads{ 0 };
+
+	// Sleeping workers.
+	std::mutex m_sleepMutex;
+	std::condition_variable m_sleepCondition;
+	std::atomic<int> m_queuedJobs{ 0 };
+	std::atomic<int> m_sleepingWorkers{ 0 };
+	std::atomic<bool> m_isShuttingDown{ false };
+
+	static inline JobSystem* Instance{ nullptr };
+
+	JobSystem() {};
+
+#pragma region Job System General Methods
+
+public:
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	/// <summary>
+	/// Creates the JobSystem and its worker threads. The calling thread becomes the thread 0 of the JobSystem.
+	/// </summary>
+	static JobSystem* InitJobSystem(unsigned int _uNumberOfWorkers);
+	inline static JobSystem* GetInstance() { return Instance; };
+	/// <summary>
+	/// Joins all worker threads. Every Job should have been waited for before calling this.
+	/// </summary>
+	static void DestroyInstance();
+
+	/// <summary>
+	/// Worker threads plus the thread that initialized the JobSystem.
+	/// </summary>
+	inline unsigned int GetNumberOfThreads() const { return m_uNumberOfThreads; };
+	/// <summary>
+	/// Index of the calling thread, between 0 and GetNumberOfThreads() - 1.
+	/// </summary>
+	unsigned int GetCurrentThreadIndex() const;
+
+#pragma endregion
+
+#pragma region Jobs
+
+public:
+	/// <summary>
+	/// Creates a Job that will not be executed until Run is called on it.
+	/// <para>If _pParent is not nullptr, the parent will not be finished until this Job is finished.</para>
+	/// </summary>
+	Job* CreateJob(JobFunction _function, Job* _pParent = nullptr);
+	/// <summary>
+	/// Creates a Job that executes the given callable. The callable is stored inside the Job, so it must fit in Job::DATA_SIZE bytes.
+	/// </summary>
+	template<typename Function> requires std::is_invocable_v<std::decay_t<Function>&>
+	Job* CreateJob(Function&& _function, Job* _pParent = nullptr);
+
+	/// <summary>
+	/// _dependent will not start until _dependency is finished. Must be called before Run(_dependent).
+	/// </summary>
+	void AddDependency(Job* _dependent, Job* _dependency);
+
+	/// <summary>
+	/// Queues the Job. It will be executed as soon as all its dependencies are finished.
+	/// </summary>
+	JobHandle Run(Job* _pJob);
+
+	static inline JobHandle GetHandle(Job* _pJob) { return JobHandle{ _pJob, _pJob->m_generation.load(std::memory_order_relaxed) }; };
+	static bool IsFinished(const JobHandle& _Handle);
+
+	/// <summary>
+	/// Executes other Jobs until the given one is finished.
+	/// </summary>
+	void Wait(const JobHandle& _Handle);
+
+	/// <summary>
+	/// Splits [0, _uCount) in chunks of at least _uGrainSize elements and calls _function(begin, end) for each chunk in parallel.
+	/// Returns when all chunks have been executed.
+	/// </summary>
+	template<typename Function>
+	void ParallelFor(unsigned int _uCount, unsigned int _uGrainSize, Function&& _function);
+
+private:
+	Job* AllocateJob();
+	void Execute(Job* _pJob);
+	void Finish(Job* _pJob);
+	void ReleaseDependency(Job* _pJob);
+	void PushJob(Job* _pJob);
+	Job* GetJob();
+
+	void WorkerThreadLoop(unsigned int _uThreadIndex);
+
+#pragma endregion
+
+};
+
+#pragma region Template Implementations
+
+template<typename Function> requires std::is_invocable_v<std::decay_t<Function>&>
+Job* JobSystem::CreateJob(Function&& _function, Job* _pParent)
+{
+	using StoredFunction = std::decay_t<Function>;
+	static_assert(sizeof(StoredFunction) <= Job::DATA_SIZE, "The callable is too big to be stored inside a Job. Capture by reference or store the data somewhere else.");
+	static_assert(alignof(StoredFunction) <= 16, "The callable has a bigger alignment than the data of a Job.");
+
+	Job* job = CreateJob(static_cast<JobFunction>([](Job*, void* _pData)
+		{
+			StoredFunction* function = std::launder(reinterpret_cast<StoredFunction*>(_pData));
+			(*function)();
+			function->~StoredFunction();
+		}), _pParent);
+
+	new (job->m_data) StoredFunction(std::forward<Function>(_function));
+
+	return job;
+}
+
+template<typename Function>
+void JobSystem::ParallelFor(unsigned int _uCount, unsigned int _uGrainSize, Function&& _function)
+{
+	if (_uCount == 0)
+	{
+		return;
+	}
+
+	_uGrainSize = std::max(_uGrainSize, 1u);
+	_uGrainSize = std::max(_uGrainSize, (_uCount + MAX_PARALLEL_FOR_CHUNKS - 1) / MAX_PARALLEL_FOR_CHUNKS);
+
+	// Not worth creating any Job.
+	if (_uCount <= _uGrainSize || m_uNumberOfThreads <= 1)
+	{
+		_function(0u, _uCount);
+		return;
+	}
+
+	Job* root = CreateJob(static_cast<JobFunction>([](Job*, void*) {}));
+
+	for (unsigned int begin = 0; begin < _uCount; begin += _uGrainSize)
+	{
+		const unsigned int end = std::min(begin + _uGrainSize, _uCount);
+		Run(CreateJob([&_function, begin, end]() { _function(begin, end); }, root));
+	}
+
+	Wait(Run(root));
+}
+
+#pragma endregion
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+struct Job;
+
+/// <summary>
+/// Fixed-size Chase-Lev deque. Only the owner thread can Push and Pop (LIFO end), any other thread can Steal (FIFO end).
+/// <para>Memory ordering follows "Correct and Efficient Work-Stealing for Weak Memory Models" (Le, Pop, Cohen, Zappa Nardelli, 2013).</para>
+/// </summary>
+class WorkStealingQueue
+{
+public:
+	static constexpr unsigned int CAPACITY{ 4096 };
+	static_assert((CAPACITY & (CAPACITY - 1)) == 0, "The capacity of a WorkStealingQueue must be a power of two.");
+
+private:
+	static constexpr int64_t MASK{ CAPACITY - 1 };
+
+	// Top and Bottom are on their own cache lines, since thieves write Top while the owner writes Bottom.
+	alignas(64) std::atomic<int64_t> m_top{ 0 };
+	alignas(64) std::atomic<int64_t> m_bottom{ 0 };
+	alignas(64) std::atomic<Job*> m_jobs[CAPACITY]{};
+
+public:
+	/// <summary>
+	/// Owner thread only. Returns false if the queue is full.
+	/// </summary>
+	bool Push(Job* _pJob)
+	{
+		const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+		const int64_t top = m_top.load(std::memory_order_acquire);
+
+		if (bottom - top >= static_cast<int64_t>(CAPACITY))
+		{
+			return false;
+		}
+
+		m_jobs[bottom & MASK].store(_pJob, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	/// <summary>
+	/// Owner thread only. Returns the most recently pushed Job, or nullptr if the queue is empty.
+	/// </summary>
+	Job* Pop()
+	{
+		const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+		m_bottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t top = m_top.load(std::memory_order_relaxed);
+
+		if (top > bottom)
+		{
+			// The queue was already empty.
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		Job* job = m_jobs[bottom & MASK].load(std::memory_order_relaxed);
+
+		if (top == bottom)
+		{
+			// Last Job in the queue, we race against thieves for it.
+			if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			{
+				job = nullptr;
+			}
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+
+		return job;
+	}
+
+	/// <summary>
+	/// Any thread. Returns the oldest Job, or nullptr if the queue is empty or another thread won the race for it.
+	/// </summary>
+	Job* Steal()
+	{
+		int64_t top = m_top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+		if (top >= bottom)
+		{
+			return nullptr;
+		}
+
+		Job* job = m_jobs[top & MASK].load(std::memory_order_relaxed);
+
+		if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		{
+			return nullptr;
+		}
+
+		return job;
+	}
+
+	inline bool IsEmpty() const { return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed); };
+};
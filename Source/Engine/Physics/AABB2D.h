@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Engine/DataTypes/Vectors/vector2d.h"
+
+/// <summary>
+/// Axis-aligned bounding box in world space.
+/// </summary>
+struct AABB2D
+{
+	vec2 m_min{ 0, 0 };
+	vec2 m_max{ 0, 0 };
+
+	inline bool Overlaps(const AABB2D& _other) const
+		{ return m_min.x < _other.m_max.x && m_max.x > _other.m_min.x && m_min.y < _other.m_max.y && m_max.y > _other.m_min.y; };
+	inline bool Contains(const AABB2D& _other) const
+		{ return m_min.x <= _other.m_min.x && m_max.x >= _other.m_max.x && m_min.y <= _other.m_min.y && m_max.y >= _other.m_max.y; };
+
+	inline vec2 GetSize() const { return m_max - m_min; };
+};
@@ -0,0 +1,77 @@
+#include "AABBTree2D.h"
+#include <algorithm>
+
+void AABBTree2D::Build(const AABB2D* _pBounds, uint32_t _uNumberOfBodies)
+{
+	Clear();
+
+	if (_uNumberOfBodies == 0)
+	{
+		return;
+	}
+
+	m_bodyBounds.assign(_pBounds, _pBounds + _uNumberOfBodies);
+	m_bodies.resize(_uNumberOfBodies);
+	for (uint32_t i = 0; i < _uNumberOfBodies; i++)
+	{
+		m_bodies[i] = i;
+	}
+
+	// A binary tree with leaves of up to MAX_BODIES_PER_LEAF bodies never has more than this many nodes.
+	m_nodes.reserve(2 * ((_uNumberOfBodies + MAX_BODIES_PER_LEAF - 1) / MAX_BODIES_PER_LEAF));
+	BuildNode(0, _uNumberOfBodies);
+}
+
+void AABBTree2D::Clear()
+{
+	m_nodes.clear();
+	m_bodies.clear();
+	m_bodyBounds.clear();
+}
+
+uint32_t AABBTree2D::BuildNode(uint32_t _uBegin, uint32_t _uEnd)
+{
+	const uint32_t nodeIndex = static_cast<uint32_t>(m_nodes.size());
+	m_nodes.emplace_back();
+
+	AABB2D bounds = m_bodyBounds[m_bodies[_uBegin]];
+	vec2 minCentre = (bounds.m_min + bounds.m_max) / 2;
+	vec2 maxCentre = minCentre;
+	for (uint32_t i = _uBegin + 1; i < _uEnd; i++)
+	{
+		const AABB2D& bodyBounds = m_bodyBounds[m_bodies[i]];
+		bounds.m_min = vec2(std::min(bounds.m_min.x, bodyBounds.m_min.x), std::min(bounds.m_min.y, bodyBounds.m_min.y));
+		bounds.m_max = vec2(std::max(bounds.m_max.x, bodyBounds.m_max.x), std::max(bounds.m_max.y, bodyBounds.m_max.y));
+
+		const vec2 centre = (bodyBounds.m_min + bodyBounds.m_max) / 2;
+		minCentre = vec2(std::min(minCentre.x, centre.x), std::min(minCentre.y, centre.y));
+		maxCentre = vec2(std::max(maxCentre.x, centre.x), std::max(maxCentre.y, centre.y));
+	}
+	m_nodes[nodeIndex].m_bounds = bounds;
+
+	if (_uEnd - _uBegin <= MAX_BODIES_PER_LEAF)
+	{
+		m_nodes[nodeIndex].m_uFirstBodyOrSecondChild = _uBegin;
+		m_nodes[nodeIndex].m_uNumberOfBodies = _uEnd - _uBegin;
+		return nodeIndex;
+	}
+
+	// Median split along the axis where the centres are most spread, which keeps the tree balanced.
+	const bool splitAlongX = maxCentre.x - minCentre.x >= maxCentre.y - minCentre.y;
+	const uint32_t middle = _uBegin + (_uEnd - _uBegin) / 2;
+	std::nth_element(m_bodies.begin() + _uBegin, m_bodies.begin() + middle, m_bodies.begin() + _uEnd,
+		[this, splitAlongX](uint32_t _first, uint32_t _second)
+		{
+			const AABB2D& first = m_bodyBounds[_first];
+			const AABB2D& second = m_bodyBounds[_second];
+			return splitAlongX ? first.m_min.x + first.m_max.x < second.m_min.x + second.m_max.x
+				: first.m_min.y + first.m_max.y < second.m_min.y + second.m_max.y;
+		});
+
+	BuildNode(_uBegin, middle);
+	const uint32_t secondChild = BuildNode(middle, _uEnd);
+
+	m_nodes[nodeIndex].m_uFirstBodyOrSecondChild = secondChild;
+	m_nodes[nodeIndex].m_uNumberOfBodies = 0;
+	return nodeIndex;
+}
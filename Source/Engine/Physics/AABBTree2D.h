@@ -0,0 +1,93 @@
+#pragma once
+
+#include "AABB2D.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// Bounding volume hierarchy over a fixed set of bounds. It's built top-down in one go and never refitted, so it's meant
+/// for colliders that don't move: building it costs O(n log n), and a query only visits the branches that overlap the box.
+/// <para>Nodes are stored in a flat array in depth-first order, and every leaf references a contiguous range of m_bodies.</para>
+/// </summary>
+class AABBTree2D
+{
+public:
+	static constexpr unsigned int MAX_BODIES_PER_LEAF{ 4 };
+
+private:
+	struct Node
+	{
+		AABB2D m_bounds;
+		// Leaves: first body of the range in m_bodies. Internal nodes: index of the second child, the first one is the next node.
+		uint32_t m_uFirstBodyOrSecondChild{ 0 };
+		// 0 for internal nodes.
+		uint32_t m_uNumberOfBodies{ 0 };
+	};
+
+	std::vector<Node> m_nodes;
+	std::vector<uint32_t> m_bodies;
+	std::vector<AABB2D> m_bodyBounds;
+
+public:
+	/// <summary>
+	/// Replaces the content of the tree. The bounds are copied, and queries report indices into _pBounds.
+	/// </summary>
+	void Build(const AABB2D* _pBounds, uint32_t _uNumberOfBodies);
+	void Clear();
+
+	/// <summary>
+	/// Calls _function(uint32_t _uBodyIndex) for every body whose bounds overlap _bounds.
+	/// </summary>
+	template<typename Function>
+	void Query(const AABB2D& _bounds, Function&& _function) const;
+
+	inline bool IsEmpty() const { return m_nodes.empty(); };
+	inline unsigned int HowManyBodies() const { return static_cast<unsigned int>(m_bodies.size()); };
+
+private:
+	uint32_t BuildNode(uint32_t _uBegin, uint32_t _uEnd);
+};
+
+#pragma region Template Implementations
+
+template<typename Function>
+void AABBTree2D::Query(const AABB2D& _bounds, Function&& _function) const
+{
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	// The depth is logarithmic in the number of bodies, so a small fixed stack is enough.
+	uint32_t stack[64];
+	unsigned int stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		const uint32_t nodeIndex = stack[--stackSize];
+		const Node& node = m_nodes[nodeIndex];
+
+		if (!node.m_bounds.Overlaps(_bounds))
+		{
+			continue;
+		}
+
+		if (node.m_uNumberOfBodies > 0)
+		{
+			for (uint32_t i = node.m_uFirstBodyOrSecondChild; i < node.m_uFirstBodyOrSecondChild + node.m_uNumberOfBodies; i++)
+			{
+				if (m_bodyBounds[m_bodies[i]].Overlaps(_bounds))
+				{
+					_function(m_bodies[i]);
+				}
+			}
+			continue;
+		}
+
+		stack[stackSize++] = node.m_uFirstBodyOrSecondChild;
+		stack[stackSize++] = nodeIndex + 1;
+	}
+}
+
+#pragma endregion
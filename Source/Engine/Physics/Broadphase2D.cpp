@@ -0,0 +1,115 @@
+#include "Broadphase2D.h"
+#include "Engine/ECS/ECS_PoolManager.h"
+#include "Engine/Components/Transform/C_Transform2D.h"
+#include "Engine/Components/Collision/C_Collider2D.h"
+#include "Engine/Components/Rigidbody/C_RigidBody2D.h"
+
+void Broadphase2D::Update(ECS_PoolManager* _PoolManager, float _deltaTime)
+{
+	if (!m_staticTreeBuilt || m_uStaticCollidersVersion != C_Collider2D::GetStaticCollidersVersion())
+	{
+		RebuildStaticColliders(_PoolManager);
+	}
+
+	m_bodies.clear();
+	m_filters.clear();
+	m_pairs.clear();
+
+	ECS_PoolManager::Iterator end = _PoolManager->EndIterator<C_Transform2D, C_Collider2D>();
+	for (ECS_PoolManager::Iterator it = _PoolManager->BeginIterator<C_Transform2D, C_Collider2D>(); it != end; ++it)
+	{
+		C_Collider2D* collider = it.GetComponent<C_Collider2D>();
+		if (collider->GetCollisionType() == C_Collider2D::CollisionType_2D::no_collision || collider->IsStatic())
+		{
+			continue;
+		}
+
+		ECS_EntityPool* pool = _PoolManager->GetEntityPool(it.m_uCurrentPoolId);
+		const unsigned int entityIndex = it.GetCurrentEntityIndex();
+
+		C_Rigidbody2D* rigidbody = nullptr;
+		if (pool->HasComponentBeenInitialized<C_Rigidbody2D>() && pool->HasComponentEnabled<C_Rigidbody2D>(entityIndex))
+		{
+			rigidbody = pool->GetComponent<C_Rigidbody2D>(entityIndex);
+		}
+
+		m_bodies.push_back(BroadphaseBody{ pool->m_entities[entityIndex].m_id, it.GetComponent<C_Transform2D>(), collider, rigidbody });
+		m_filters.push_back(collider->GetCollisionFilter());
+	}
+
+	const uint32_t numberOfBodies = static_cast<uint32_t>(m_bodies.size());
+	m_worldCache.Resize(numberOfBodies);
+
+	auto fillWorldCache = [this, _deltaTime](unsigned int _uBegin, unsigned int _uEnd)
+		{
+			for (unsigned int i = _uBegin; i < _uEnd; i++)
+			{
+				// C_Rigidbody2D::UpdatePhysics moves the body by its final velocity, so this is where it started the step.
+				const vec2 displacement = m_bodies[i].m_pRigidbody != nullptr ? m_bodies[i].m_pRigidbody->m_velocity * _deltaTime : vec2(0, 0);
+				m_worldCache.Compute(i, *m_bodies[i].m_pCollider, *m_bodies[i].m_pTransform, displacement);
+			}
+		};
+
+	if (JobSystem* jobSystem = JobSystem::GetInstance())
+	{
+		jobSystem->ParallelFor(numberOfBodies, BATCH_SIZE, fillWorldCache);
+	}
+	else
+	{
+		fillWorldCache(0, numberOfBodies);
+	}
+
+	m_grid.Build(m_worldCache.GetBoundsData(), numberOfBodies, m_fixedCellSize);
+	m_grid.FindPairs(m_pairs, m_filters.data());
+
+	// Static bodies are indexed after the dynamic ones, so the dynamic body is always the first of the pair.
+	if (!m_staticTree.IsEmpty())
+	{
+		for (uint32_t i = 0; i < numberOfBodies; i++)
+		{
+			if ((m_filters[i].m_uMask & m_uStaticCategories) == 0)
+			{
+				continue;
+			}
+
+			m_staticTree.Query(m_worldCache.GetBounds(i), [this, i, numberOfBodies](uint32_t _uStaticBody)
+				{
+					if (m_filters[i].CanCollideWith(m_staticFilters[_uStaticBody]))
+					{
+						m_pairs.push_back(BroadphasePair{ i, numberOfBodies + _uStaticBody });
+					}
+				});
+		}
+	}
+}
+
+void Broadphase2D::RebuildStaticColliders(ECS_PoolManager* _PoolManager)
+{
+	// Read first, so changes made while rebuilding trigger another rebuild.
+	m_uStaticCollidersVersion = C_Collider2D::GetStaticCollidersVersion();
+	m_staticTreeBuilt = true;
+
+	m_staticBodies.clear();
+	m_staticWorldCache.Clear();
+	m_staticFilters.clear();
+	m_uStaticCategories = 0;
+
+	ECS_PoolManager::Iterator end = _PoolManager->EndIterator<C_Transform2D, C_Collider2D>();
+	for (ECS_PoolManager::Iterator it = _PoolManager->BeginIterator<C_Transform2D, C_Collider2D>(); it != end; ++it)
+	{
+		C_Collider2D* collider = it.GetComponent<C_Collider2D>();
+		if (collider->GetCollisionType() == C_Collider2D::CollisionType_2D::no_collision || !collider->IsStatic())
+		{
+			continue;
+		}
+
+		C_Transform2D* transform = it.GetComponent<C_Transform2D>();
+		const EntityID entityId = _PoolManager->GetEntityPool(it.m_uCurrentPoolId)->m_entities[it.GetCurrentEntityIndex()].m_id;
+		m_staticBodies.push_back(BroadphaseBody{ entityId, transform, collider, nullptr });
+		m_staticWorldCache.Add(*collider, *transform);
+		m_staticFilters.push_back(collider->GetCollisionFilter());
+		m_uStaticCategories |= collider->m_uCollisionCategory;
+	}
+
+	m_staticTree.Build(m_staticWorldCache.GetBoundsData(), m_staticWorldCache.Size());
+}
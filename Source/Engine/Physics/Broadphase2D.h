@@ -0,0 +1,90 @@
+#pragma once
+
+#include "SpatialHashGrid.h"
+#include "AABBTree2D.h"
+#include "ColliderWorldCache.h"
+#include "Engine/ECS/ECS_Typedefs.h"
+#include <vector>
+
+struct C_Transform2D;
+struct C_Collider2D;
+struct C_Rigidbody2D;
+
+/// <summary>
+/// Collider registered in the broadphase this step.
+/// </summary>
+struct BroadphaseBody
+{
+	EntityID m_entityId;
+	C_Transform2D* m_pTransform;
+	C_Collider2D* m_pCollider;
+	// nullptr for bodies without a Rigidbody, which don't move during the physics step.
+	C_Rigidbody2D* m_pRigidbody;
+};
+
+/// <summary>
+/// Finds the pairs of colliders that may be touching, so collision Systems only run the exact tests on them instead of on every pair.
+/// <para>The Engine updates it after the Physics Systems of every step, from every Entity with a C_Transform2D and a C_Collider2D,
+/// and the Systems of the Collision phase read the result.</para>
+/// <para>Dynamic colliders go into a spatial hash grid rebuilt every step. Static colliders go into an AABB tree that is only rebuilt
+/// when they change, and every dynamic collider queries it. Pairs of two static colliders are never reported.
+/// Body indices cover the dynamic bodies first and the static ones after them.</para>
+/// <para>Pairs whose collision filters don't match are rejected with a bitwise test before their bounds are compared.</para>
+/// </summary>
+class Broadphase2D
+{
+public:
+	// Filling the world cache of a body is cheap, so batches have to be big for a Job to be worth it.
+	static constexpr unsigned int BATCH_SIZE{ 1024 };
+
+private:
+	std::vector<BroadphaseBody> m_bodies;
+	std::vector<CollisionFilter> m_filters;
+	ColliderWorldCache m_worldCache;
+	std::vector<BroadphasePair> m_pairs;
+
+	SpatialHashGrid m_grid;
+
+	std::vector<BroadphaseBody> m_staticBodies;
+	ColliderWorldCache m_staticWorldCache;
+	std::vector<CollisionFilter> m_staticFilters;
+	// Every category of the static bodies, so dynamic bodies that can't collide with any of them skip the tree.
+	uint32_t m_uStaticCategories{ 0 };
+	AABBTree2D m_staticTree;
+	uint32_t m_uStaticCollidersVersion{ 0 };
+	bool m_staticTreeBuilt{ false };
+	// 0 or less tunes the cell size to the bodies every step.
+	float m_fixedCellSize{ 0 };
+
+public:
+	/// <summary>
+	/// Gathers the colliders, fills their world cache and rebuilds the grid and the candidate pairs.
+	/// <para>_deltaTime is the step the Rigidbodies have just been integrated with, to know where they started it.</para>
+	/// </summary>
+	void Update(ECS_PoolManager* _PoolManager, float _deltaTime);
+	/// <summary>
+	/// Rebuilds the tree of static colliders. Update already does it when they change, but loading a level can do it upfront.
+	/// </summary>
+	void RebuildStaticColliders(ECS_PoolManager* _PoolManager);
+
+	inline void SetFixedCellSize(float _cellSize) { m_fixedCellSize = _cellSize; };
+	inline float GetCellSize() const { return m_grid.GetCellSize(); };
+
+	inline const std::vector<BroadphasePair>& GetCandidatePairs() const { return m_pairs; };
+	inline uint32_t HowManyBodies() const { return static_cast<uint32_t>(m_bodies.size() + m_staticBodies.size()); };
+	inline uint32_t HowManyDynamicBodies() const { return static_cast<uint32_t>(m_bodies.size()); };
+	inline bool IsBodyStatic(uint32_t _uBodyIndex) const { return _uBodyIndex >= m_bodies.size(); };
+	inline const BroadphaseBody& GetBody(uint32_t _uBodyIndex) const
+		{ return IsBodyStatic(_uBodyIndex) ? m_staticBodies[_uBodyIndex - m_bodies.size()] : m_bodies[_uBodyIndex]; };
+
+	// World-space data of the bodies, computed once per step (or once per rebuild for static bodies).
+	inline const AABB2D& GetBounds(uint32_t _uBodyIndex) const
+		{ return IsBodyStatic(_uBodyIndex) ? m_staticWorldCache.GetBounds(_uBodyIndex - HowManyDynamicBodies()) : m_worldCache.GetBounds(_uBodyIndex); };
+	inline const NarrowphaseShape& GetShape(uint32_t _uBodyIndex) const
+		{ return IsBodyStatic(_uBodyIndex) ? m_staticWorldCache.GetShape(_uBodyIndex - HowManyDynamicBodies()) : m_worldCache.GetShape(_uBodyIndex); };
+	inline const ColliderCorners& GetCorners(uint32_t _uBodyIndex) const
+		{ return IsBodyStatic(_uBodyIndex) ? m_staticWorldCache.GetCorners(_uBodyIndex - HowManyDynamicBodies()) : m_worldCache.GetCorners(_uBodyIndex); };
+	inline vec2 GetDisplacement(uint32_t _uBodyIndex) const
+		{ return IsBodyStatic(_uBodyIndex) ? vec2(0, 0) : m_worldCache.GetDisplacement(_uBodyIndex); };
+	inline bool IsBodyFast(uint32_t _uBodyIndex) const { return !IsBodyStatic(_uBodyIndex) && m_worldCache.IsFast(_uBodyIndex); };
+};
@@ -0,0 +1,62 @@
+#include "ColliderWorldCache.h"
+#include <algorithm>
+#include <cmath>
+
+void ColliderWorldCache::Clear()
+{
+	m_bounds.clear();
+	m_shapes.clear();
+	m_corners.clear();
+	m_displacements.clear();
+}
+
+void ColliderWorldCache::Resize(uint32_t _uNumberOfColliders)
+{
+	m_bounds.resize(_uNumberOfColliders);
+	m_shapes.resize(_uNumberOfColliders);
+	m_corners.resize(_uNumberOfColliders);
+	m_displacements.resize(_uNumberOfColliders);
+}
+
+void ColliderWorldCache::Compute(uint32_t _uIndex, const C_Collider2D& _collider, const C_Transform2D& _transform, const vec2& _displacement)
+{
+	// The sine and cosine are only computed here. Corners and bounds are derived from the shape.
+	const NarrowphaseShape shape = NARROWPHASE::CalculateShape(_collider, _transform);
+
+	// Local axes of the box. vec2::RotateBy maps (1, 0) and (0, 1) to these.
+	const vec2 axisX = vec2(shape.m_cos, -shape.m_sin) * shape.m_halfExtents.x;
+	const vec2 axisY = vec2(shape.m_sin, shape.m_cos) * shape.m_halfExtents.y;
+
+	ColliderCorners& corners = m_corners[_uIndex];
+	/* topLeft */			corners.m_points[0] = shape.m_centre - axisX - axisY;
+	/* bottomLeft */	corners.m_points[1] = shape.m_centre - axisX + axisY;
+	/* topRight */		corners.m_points[2] = shape.m_centre + axisX - axisY;
+	/* bottomRight */	corners.m_points[3] = shape.m_centre + axisX + axisY;
+
+	// Same extents as C_Collider2D::GetWorldAABB: the projection of the box on the world axes. Then grown back to where the step started.
+	const vec2 extents(std::abs(axisX.x) + std::abs(axisY.x), std::abs(axisX.y) + std::abs(axisY.y));
+	const vec2 start = shape.m_centre - _displacement;
+	m_bounds[_uIndex] = AABB2D{
+		vec2(std::min(shape.m_centre.x, start.x), std::min(shape.m_centre.y, start.y)) - extents,
+		vec2(std::max(shape.m_centre.x, start.x), std::max(shape.m_centre.y, start.y)) + extents };
+
+	m_shapes[_uIndex] = shape;
+	m_displacements[_uIndex] = _displacement;
+}
+
+bool ColliderWorldCache::IsFast(uint32_t _uIndex) const
+{
+	// Moving less than half of its smallest size, a collider can't skip over anything without overlapping it at the start or at the end.
+	const vec2& displacement = m_displacements[_uIndex];
+	const NarrowphaseShape& shape = m_shapes[_uIndex];
+	const float smallestHalfExtent = std::min(shape.m_halfExtents.x, shape.m_halfExtents.y);
+
+	return displacement.Dot(displacement) > smallestHalfExtent * smallestHalfExtent;
+}
+
+void ColliderWorldCache::Add(const C_Collider2D& _collider, const C_Transform2D& _transform)
+{
+	const uint32_t index = Size();
+	Resize(index + 1);
+	Compute(index, _collider, _transform);
+}
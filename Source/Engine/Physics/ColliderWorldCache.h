@@ -0,0 +1,60 @@
+#pragma once
+
+#include "AABB2D.h"
+#include "NarrowphaseKernels.h"
+#include <cstdint>
+#include <vector>
+
+struct C_Transform2D;
+struct C_Collider2D;
+
+/// <summary>
+/// Corners of an oriented box in world space, in the same order as the SAT tests of C_Collider2D:
+/// [0] = topLeft, [1] = bottomLeft, [2] = topRight, [3] = bottomRight.
+/// <para>Circles store the corners of their bounds.</para>
+/// </summary>
+struct ColliderCorners
+{
+	vec2 m_points[4];
+};
+
+/// <summary>
+/// World-space data of a set of colliders, computed once per step from their C_Transform2D and C_Collider2D.
+/// <para>A collider can be part of many pairs. The broadphase and the narrowphase read its bounds, shape and corners from here
+/// instead of recomputing them from the Components for every pair.</para>
+/// <para>Kept as a structure of arrays, so the bounds are contiguous for the spatial hash grid and the AABB tree.</para>
+/// <para>Shapes and corners are where the colliders are at the end of the step. Their bounds also cover the movement of the step,
+/// so the broadphase reports the pairs that fast bodies crossed on the way.</para>
+/// </summary>
+class ColliderWorldCache
+{
+	std::vector<AABB2D> m_bounds;
+	std::vector<NarrowphaseShape> m_shapes;
+	std::vector<ColliderCorners> m_corners;
+	std::vector<vec2> m_displacements;
+
+public:
+	void Clear();
+	/// <summary>
+	/// Resizes the cache to the given number of colliders. Their entries are filled later with Compute.
+	/// </summary>
+	void Resize(uint32_t _uNumberOfColliders);
+	/// <summary>
+	/// Fills the entry of a collider. Different entries can be computed from different threads at the same time.
+	/// </summary>
+	void Compute(uint32_t _uIndex, const C_Collider2D& _collider, const C_Transform2D& _transform, const vec2& _displacement = vec2(0, 0));
+	void Add(const C_Collider2D& _collider, const C_Transform2D& _transform);
+
+	inline uint32_t Size() const { return static_cast<uint32_t>(m_bounds.size()); };
+	inline const AABB2D* GetBoundsData() const { return m_bounds.data(); };
+
+	inline const AABB2D& GetBounds(uint32_t _uIndex) const { return m_bounds[_uIndex]; };
+	inline const NarrowphaseShape& GetShape(uint32_t _uIndex) const { return m_shapes[_uIndex]; };
+	inline const ColliderCorners& GetCorners(uint32_t _uIndex) const { return m_corners[_uIndex]; };
+	// Movement of the collider during the step.
+	inline const vec2& GetDisplacement(uint32_t _uIndex) const { return m_displacements[_uIndex]; };
+	/// <summary>
+	/// Whether the collider moved so much during the step that it could have gone through something without overlapping it at the end.
+	/// </summary>
+	bool IsFast(uint32_t _uIndex) const;
+};
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+/// <summary>
+/// Which categories a collider belongs to, and which categories it collides with. Two colliders only collide when each one's
+/// category is in the other one's mask, so either of them can opt out.
+/// </summary>
+struct CollisionFilter
+{
+	uint32_t m_uCategory{ 1 };
+	uint32_t m_uMask{ 0xFFFFFFFF };
+
+	inline bool CanCollideWith(const CollisionFilter& _other) const { return (m_uCategory & _other.m_uMask) != 0 && (_other.m_uCategory & m_uMask) != 0; };
+};
@@ -0,0 +1,259 @@
+#include "CollisionPipeline2D.h"
+#include "Engine/Components/Transform/C_Transform2D.h"
+#include "SweptCollision.h"
+#include "Engine/Jobs/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+	inline vec2 GetAxisX(const NarrowphaseShape& _shape) { return vec2(_shape.m_cos, -_shape.m_sin); }
+	inline vec2 GetAxisY(const NarrowphaseShape& _shape) { return vec2(_shape.m_sin, _shape.m_cos); }
+
+	// Contact of a circle against an oriented box, with the normal pointing from the box to the circle.
+	void CalculateBoxCircleContact(const NarrowphaseShape& _box, const NarrowphaseShape& _circle, vec2& _normal, float& _depth)
+	{
+		const vec2 axisX = GetAxisX(_box);
+		const vec2 axisY = GetAxisY(_box);
+		const vec2 difference = _circle.m_centre - _box.m_centre;
+		const vec2 localCentre(difference.Dot(axisX), difference.Dot(axisY));
+		const vec2 halfExtents = _box.m_halfExtents;
+		const float radius = _circle.m_halfExtents.x;
+
+		// Working in the space of the box, where it is a rectangle centred on the origin.
+		const vec2 closestPoint(std::clamp(localCentre.x, -halfExtents.x, halfExtents.x), std::clamp(localCentre.y, -halfExtents.y, halfExtents.y));
+		const vec2 toCentre = localCentre - closestPoint;
+		const float distance = toCentre.Length();
+
+		vec2 localNormal;
+		if (distance > 0)
+		{
+			localNormal = toCentre / distance;
+			_depth = radius - distance;
+		}
+		else
+		{
+			// The centre is inside the box, so it leaves through the closest side.
+			const float toLeft = localCentre.x + halfExtents.x;
+			const float toRight = halfExtents.x - localCentre.x;
+			const float toTop = localCentre.y + halfExtents.y;
+			const float toBottom = halfExtents.y - localCentre.y;
+			const float closestSide = std::min(std::min(toLeft, toRight), std::min(toTop, toBottom));
+
+			if (closestSide == toLeft) { localNormal = vec2(-1, 0); }
+			else if (closestSide == toRight) { localNormal = vec2(1, 0); }
+			else if (closestSide == toTop) { localNormal = vec2(0, -1); }
+			else { localNormal = vec2(0, 1); }
+
+			_depth = closestSide + radius;
+		}
+
+		_normal = axisX * localNormal.x + axisY * localNormal.y;
+	}
+
+	// Separating axis test on the corners of two boxes, keeping the axis where they overlap the least. The normal points from A to B.
+	void CalculateBoxBoxContact(const NarrowphaseShape& _boxA, const ColliderCorners& _cornersA, const NarrowphaseShape& _boxB, const ColliderCorners& _cornersB, vec2& _normal, float& _depth)
+	{
+		const vec2 axes[4] = { GetAxisX(_boxA), GetAxisY(_boxA), GetAxisX(_boxB), GetAxisY(_boxB) };
+		const vec2 difference = _boxB.m_centre - _boxA.m_centre;
+
+		_depth = std::numeric_limits<float>::max();
+		for (const vec2& axis : axes)
+		{
+			float minA = std::numeric_limits<float>::max(), maxA = std::numeric_limits<float>::lowest();
+			float minB = std::numeric_limits<float>::max(), maxB = std::numeric_limits<float>::lowest();
+			for (unsigned int i = 0; i < 4; i++)
+			{
+				const float projectionA = _cornersA.m_points[i].Dot(axis);
+				const float projectionB = _cornersB.m_points[i].Dot(axis);
+				minA = std::min(minA, projectionA);
+				maxA = std::max(maxA, projectionA);
+				minB = std::min(minB, projectionB);
+				maxB = std::max(maxB, projectionB);
+			}
+
+			const float overlap = std::min(maxA, maxB) - std::max(minA, minB);
+			if (overlap < _depth)
+			{
+				_depth = overlap;
+				_normal = difference.Dot(axis) < 0 ? axis * -1 : axis;
+			}
+		}
+	}
+}
+
+void CollisionPipeline2D::Update(ECS_PoolManager* _PoolManager, float _deltaTime)
+{
+	m_broadphase.Update(_PoolManager, _deltaTime);
+
+	m_pairCache.BeginStep(m_broadphase);
+
+	const std::vector<BroadphasePair>& pairs = m_broadphase.GetCandidatePairs();
+	const uint32_t numberOfPairs = static_cast<uint32_t>(pairs.size());
+
+	// Sorting the pairs by kind, so every kernel runs on full lanes of the same test.
+	m_circleCircleBatch.Clear();
+	m_boxCircleBatch.Clear();
+	m_boxBoxBatch.Clear();
+
+	for (uint32_t i = 0; i < numberOfPairs; i++)
+	{
+		if (m_pairCache.IsPairReusable(i))
+		{
+			continue;
+		}
+
+		const NarrowphaseShape& first = m_broadphase.GetShape(pairs[i].m_uFirst);
+		const NarrowphaseShape& second = m_broadphase.GetShape(pairs[i].m_uSecond);
+
+		if (first.m_isCircle && second.m_isCircle)
+		{
+			m_circleCircleBatch.Add(first, second, i);
+		}
+		else if (first.m_isCircle)
+		{
+			m_boxCircleBatch.Add(second, first, i);
+		}
+		else if (second.m_isCircle)
+		{
+			m_boxCircleBatch.Add(first, second, i);
+		}
+		else
+		{
+			m_boxBoxBatch.Add(first, second, i);
+		}
+	}
+
+	RunNarrowphaseKernel(m_circleCircleBatch, &NARROWPHASE::TestCircleCircle);
+	RunNarrowphaseKernel(m_boxCircleBatch, &NARROWPHASE::TestBoxCircle);
+	RunNarrowphaseKernel(m_boxBoxBatch, &NARROWPHASE::TestBoxBox);
+
+	m_arePairsTouching.assign(numberOfPairs, 0);
+	for (const NarrowphaseBatch* batch : { &m_circleCircleBatch, &m_boxCircleBatch, &m_boxBoxBatch })
+	{
+		for (uint32_t lane = 0; lane < batch->Size(); lane++)
+		{
+			if (batch->IsHit(lane))
+			{
+				m_arePairsTouching[batch->m_pairIndices[lane]] = 1;
+			}
+		}
+	}
+
+	// Only the pairs that touch need a normal and a depth, and there are usually few of them.
+	m_contacts.clear();
+	for (uint32_t i = 0; i < numberOfPairs; i++)
+	{
+		Contact2D contact;
+
+		if (m_pairCache.IsPairReusable(i))
+		{
+			if (m_pairCache.GetCachedResult(i, m_broadphase, contact))
+			{
+				m_contacts.push_back(contact);
+			}
+			continue;
+		}
+
+		bool isTouching = m_arePairsTouching[i];
+		if (isTouching)
+		{
+			CalculateContact(m_broadphase, pairs[i].m_uFirst, pairs[i].m_uSecond, contact);
+		}
+		else if (m_broadphase.IsBodyFast(pairs[i].m_uFirst) || m_broadphase.IsBodyFast(pairs[i].m_uSecond))
+		{
+			isTouching = SweepPair(m_broadphase, pairs[i].m_uFirst, pairs[i].m_uSecond, contact);
+		}
+
+		if (isTouching)
+		{
+			m_contacts.push_back(contact);
+		}
+
+		m_pairCache.StoreResult(i, m_broadphase, isTouching, &contact);
+	}
+
+	m_pairCache.EndStep(m_broadphase);
+}
+
+void CollisionPipeline2D::RunNarrowphaseKernel(NarrowphaseBatch& _batch, void (*_kernel)(NarrowphaseBatch&, uint32_t, uint32_t))
+{
+	_batch.PrepareHitMask();
+
+	const uint32_t numberOfLanes = _batch.Size();
+	JobSystem* jobSystem = JobSystem::GetInstance();
+
+	if (jobSystem == nullptr || numberOfLanes <= NARROWPHASE_BATCH_SIZE)
+	{
+		_kernel(_batch, 0, numberOfLanes);
+		return;
+	}
+
+	// Splitting by bytes of the hit mask, so every Job writes its own bytes.
+	constexpr uint32_t lanesPerByte = NARROWPHASE::LANES_PER_MASK_BYTE;
+	const uint32_t numberOfBytes = (numberOfLanes + lanesPerByte - 1) / lanesPerByte;
+
+	jobSystem->ParallelFor(numberOfBytes, NARROWPHASE_BATCH_SIZE / lanesPerByte, [&_batch, _kernel, numberOfLanes](unsigned int _uBegin, unsigned int _uEnd)
+		{
+			_kernel(_batch, _uBegin * lanesPerByte, std::min(_uEnd * lanesPerByte, numberOfLanes));
+		});
+}
+
+void CollisionPipeline2D::CalculateContact(const Broadphase2D& _broadphase, uint32_t _uBodyA, uint32_t _uBodyB, Contact2D& _contact)
+{
+	const BroadphaseBody& bodyA = _broadphase.GetBody(_uBodyA);
+	const BroadphaseBody& bodyB = _broadphase.GetBody(_uBodyB);
+
+	_contact.m_entityA = bodyA.m_entityId;
+	_contact.m_entityB = bodyB.m_entityId;
+	_contact.m_uBodyA = _uBodyA;
+	_contact.m_uBodyB = _uBodyB;
+	_contact.m_timeOfImpact = 1;
+
+	const NarrowphaseShape& shapeA = _broadphase.GetShape(_uBodyA);
+	const NarrowphaseShape& shapeB = _broadphase.GetShape(_uBodyB);
+
+	if (shapeA.m_isCircle && shapeB.m_isCircle)
+	{
+		const vec2 difference = shapeB.m_centre - shapeA.m_centre;
+		const float distance = difference.Length();
+		_contact.m_normal = distance > 0 ? difference / distance : vec2(0, 1);
+		_contact.m_depth = shapeA.m_halfExtents.x + shapeB.m_halfExtents.x - distance;
+	}
+	else if (shapeB.m_isCircle)
+	{
+		CalculateBoxCircleContact(shapeA, shapeB, _contact.m_normal, _contact.m_depth);
+	}
+	else if (shapeA.m_isCircle)
+	{
+		CalculateBoxCircleContact(shapeB, shapeA, _contact.m_normal, _contact.m_depth);
+		_contact.m_normal = _contact.m_normal * -1;
+	}
+	else
+	{
+		CalculateBoxBoxContact(shapeA, _broadphase.GetCorners(_uBodyA), shapeB, _broadphase.GetCorners(_uBodyB), _contact.m_normal, _contact.m_depth);
+	}
+
+	_contact.m_depth = std::max(_contact.m_depth, 0.0f);
+}
+
+bool CollisionPipeline2D::SweepPair(const Broadphase2D& _broadphase, uint32_t _uBodyA, uint32_t _uBodyB, Contact2D& _contact)
+{
+	float toi;
+	vec2 normal;
+	if (!SWEPT::SweepShapes(_broadphase.GetShape(_uBodyA), _broadphase.GetDisplacement(_uBodyA), _broadphase.GetShape(_uBodyB), _broadphase.GetDisplacement(_uBodyB), toi, normal))
+	{
+		return false;
+	}
+
+	_contact.m_entityA = _broadphase.GetBody(_uBodyA).m_entityId;
+	_contact.m_entityB = _broadphase.GetBody(_uBodyB).m_entityId;
+	_contact.m_uBodyA = _uBodyA;
+	_contact.m_uBodyB = _uBodyB;
+	// SweepShapes gives the normal from B towards A.
+	_contact.m_normal = normal * -1;
+	_contact.m_depth = 0;
+	_contact.m_timeOfImpact = toi;
+	return true;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Broadphase2D.h"
+#include "Contact2D.h"
+#include "ContactPairCache.h"
+#include "Engine/ECS/ECS_Typedefs.h"
+#include <vector>
+
+/// <summary>
+/// Collision stage of every step: runs the broadphase, sorts the candidate pairs by kind into SoA batches, tests them with the
+/// SIMD narrowphase kernels on the workers and stores the touching ones in a contiguous contact list, in the order of the broadphase pairs.
+/// <para>Pairs with a fast body that don't overlap at the end of the step are swept, so bodies that crossed each other during it still touch.</para>
+/// <para>Pairs whose bodies didn't move since their last test, or that were apart and haven't moved far enough to meet, reuse that result
+/// from the pair cache, which also turns the contacts into begin/stay/end events.</para>
+/// <para>Systems of the Collision phase consume the contacts and the events instead of looping over colliders themselves.</para>
+/// </summary>
+class CollisionPipeline2D
+{
+public:
+	// Lanes tested by each Job. A multiple of 8, so Jobs never share a byte of the hit masks.
+	static constexpr unsigned int NARROWPHASE_BATCH_SIZE{ 1024 };
+	static_assert(NARROWPHASE_BATCH_SIZE % NARROWPHASE::LANES_PER_MASK_BYTE == 0, "Narrowphase Jobs must cover whole bytes of the hit masks.");
+
+private:
+	Broadphase2D m_broadphase;
+	ContactPairCache m_pairCache;
+
+	NarrowphaseBatch m_circleCircleBatch;
+	NarrowphaseBatch m_boxCircleBatch;
+	NarrowphaseBatch m_boxBoxBatch;
+
+	std::vector<Contact2D> m_contacts;
+	std::vector<unsigned char> m_arePairsTouching;
+
+public:
+	void Update(ECS_PoolManager* _PoolManager, float _deltaTime);
+
+	inline Broadphase2D* GetBroadphase() { return &m_broadphase; };
+	inline const Broadphase2D* GetBroadphase() const { return &m_broadphase; };
+	inline const std::vector<Contact2D>& GetContacts() const { return m_contacts; };
+	inline const ContactPairCache& GetPairCache() const { return m_pairCache; };
+	/// <summary>
+	/// Begin, stay and end events of this step. Begin and stay events come in the same order as the contacts.
+	/// </summary>
+	inline const std::vector<ContactEvent>& GetContactEvents() const { return m_pairCache.GetEvents(); };
+
+	/// <summary>
+	/// Normal and depth of two bodies that are known to overlap, read from the world cache of the broadphase.
+	/// <para>Boxes use the separating axis where they overlap the least, and circles the closest point of the other shape.</para>
+	/// </summary>
+	static void CalculateContact(const Broadphase2D& _broadphase, uint32_t _uBodyA, uint32_t _uBodyB, Contact2D& _contact);
+	/// <summary>
+	/// Time of impact of two bodies that don't overlap at the end of the step, along their movement during it. Fills _contact when they met.
+	/// </summary>
+	static bool SweepPair(const Broadphase2D& _broadphase, uint32_t _uBodyA, uint32_t _uBodyB, Contact2D& _contact);
+
+private:
+	void RunNarrowphaseKernel(NarrowphaseBatch& _batch, void (*_kernel)(NarrowphaseBatch&, uint32_t, uint32_t));
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Engine/DataTypes/Vectors/vector2d.h"
+#include "Engine/ECS/ECS_Typedefs.h"
+#include <cstdint>
+
+/// <summary>
+/// Two colliders touching in the current step. The normal points from A to B, and moving B by m_normal * m_depth separates them.
+/// </summary>
+struct Contact2D
+{
+	EntityID m_entityA;
+	EntityID m_entityB;
+	vec2 m_normal;
+	float m_depth;
+	// Fraction of the step where the bodies touch. 1 for bodies that overlap at the end of the step, less for fast bodies
+	// that met during the step, whose depth is 0 and whose normal is the one at the time of impact.
+	float m_timeOfImpact;
+
+	// Broadphase body indices, to reach the Transforms and Colliders without looking the Entities up.
+	uint32_t m_uBodyA;
+	uint32_t m_uBodyB;
+};
+
+enum class ContactEventType : unsigned char
+{
+	Begin,	// The pair touches this step, but didn't in the previous one.
+	Stay,		// The pair touched in the previous step and still does.
+	End,		// The pair touched in the previous step, but doesn't anymore. One of its Entities may have been destroyed.
+};
+
+/// <summary>
+/// Change in the contact state of a pair of Entities between two steps.
+/// </summary>
+struct ContactEvent
+{
+	ContactEventType m_type;
+	EntityID m_entityA;
+	EntityID m_entityB;
+};
@@ -0,0 +1,250 @@
+#include "ContactPairCache.h"
+#include <algorithm>
+#include <assert.h>
+#include <cmath>
+#include <functional>
+
+namespace
+{
+	// Margin over the rounding of the separations and of the narrowphase kernels, in world units.
+	static constexpr float SEPARATION_TOLERANCE{ 0.001f };
+
+	// Exact comparison on purpose: a body that moved by any amount has to be tested again.
+	inline bool AreShapesEqual(const NarrowphaseShape& _a, const NarrowphaseShape& _b)
+	{
+		return _a.m_centre.x == _b.m_centre.x && _a.m_centre.y == _b.m_centre.y
+			&& _a.m_halfExtents.x == _b.m_halfExtents.x && _a.m_halfExtents.y == _b.m_halfExtents.y
+			&& _a.m_cos == _b.m_cos && _a.m_sin == _b.m_sin && _a.m_isCircle == _b.m_isCircle;
+	}
+
+	// Same size, rotation and kind, so the shape can only have moved.
+	inline bool HaveSameForm(const NarrowphaseShape& _a, const NarrowphaseShape& _b)
+	{
+		return _a.m_halfExtents.x == _b.m_halfExtents.x && _a.m_halfExtents.y == _b.m_halfExtents.y
+			&& _a.m_cos == _b.m_cos && _a.m_sin == _b.m_sin && _a.m_isCircle == _b.m_isCircle;
+	}
+
+	// Distance from the centre of a circle to an oriented box, minus the radius. Uses the axes of the narrowphase kernels.
+	inline float CalculateBoxCircleSeparation(const NarrowphaseShape& _box, const NarrowphaseShape& _circle)
+	{
+		const vec2 difference = _circle.m_centre - _box.m_centre;
+		const float outsideX = std::max(std::abs(difference.x * _box.m_cos - difference.y * _box.m_sin) - _box.m_halfExtents.x, 0.0f);
+		const float outsideY = std::max(std::abs(difference.x * _box.m_sin + difference.y * _box.m_cos) - _box.m_halfExtents.y, 0.0f);
+		return std::sqrt(outsideX * outsideX + outsideY * outsideY) - _circle.m_halfExtents.x;
+	}
+
+	/// <summary>
+	/// Lower bound of the distance between two shapes: exact when a circle is involved, the widest gap along the separating axes for two boxes.
+	/// <para>When the shapes only move, the distance between them shrinks by the distance they moved at most, so the pair can't touch
+	/// until they have moved that far in total.</para>
+	/// </summary>
+	float CalculateSeparation(const NarrowphaseShape& _a, const NarrowphaseShape& _b)
+	{
+		if (_a.m_isCircle && _b.m_isCircle)
+		{
+			return (_b.m_centre - _a.m_centre).Length() - _a.m_halfExtents.x - _b.m_halfExtents.x;
+		}
+		if (_a.m_isCircle)
+		{
+			return CalculateBoxCircleSeparation(_b, _a);
+		}
+		if (_b.m_isCircle)
+		{
+			return CalculateBoxCircleSeparation(_a, _b);
+		}
+
+		const vec2 difference = _b.m_centre - _a.m_centre;
+		const float sameAxes = std::abs(_a.m_cos * _b.m_cos + _a.m_sin * _b.m_sin);
+		const float crossedAxes = std::abs(_a.m_cos * _b.m_sin - _a.m_sin * _b.m_cos);
+
+		float separation = std::abs(difference.x * _a.m_cos - difference.y * _a.m_sin) - (_a.m_halfExtents.x + _b.m_halfExtents.x * sameAxes + _b.m_halfExtents.y * crossedAxes);
+		separation = std::max(separation, std::abs(difference.x * _a.m_sin + difference.y * _a.m_cos) - (_a.m_halfExtents.y + _b.m_halfExtents.x * crossedAxes + _b.m_halfExtents.y * sameAxes));
+		separation = std::max(separation, std::abs(difference.x * _b.m_cos - difference.y * _b.m_sin) - (_b.m_halfExtents.x + _a.m_halfExtents.x * sameAxes + _a.m_halfExtents.y * crossedAxes));
+		separation = std::max(separation, std::abs(difference.x * _b.m_sin + difference.y * _b.m_cos) - (_b.m_halfExtents.y + _a.m_halfExtents.x * crossedAxes + _a.m_halfExtents.y * sameAxes));
+		return separation;
+	}
+}
+
+size_t ContactPairCache::PairKeyHash::operator()(const PairKey& _key) const
+{
+	const size_t firstHash = std::hash<EntityID>{}(_key.m_first);
+	return firstHash ^ (std::hash<EntityID>{}(_key.m_second) + 0x9E3779B97F4A7C15ull + (firstHash << 6) + (firstHash >> 2));
+}
+
+ContactPairCache::PairKey ContactPairCache::GetKey(const BroadphaseBody& _first, const BroadphaseBody& _second)
+{
+	// The order of the bodies of a pair can change between steps, the order of their Entity IDs can't.
+	return _first.m_entityId < _second.m_entityId ? PairKey{ _first.m_entityId, _second.m_entityId } : PairKey{ _second.m_entityId, _first.m_entityId };
+}
+
+ContactPairCache::CachedPair& ContactPairCache::FindOrCreatePair(const PairKey& _key, bool& _isNewPair)
+{
+	auto iterator = m_cachedPairs.find(_key);
+	_isNewPair = iterator == m_cachedPairs.end();
+	if (!_isNewPair)
+	{
+		return iterator->second;
+	}
+
+	if (m_freeNodes.empty())
+	{
+		return m_cachedPairs.try_emplace(_key).first->second;
+	}
+
+	CachedPairMap::node_type node = std::move(m_freeNodes.back());
+	m_freeNodes.pop_back();
+	node.key() = _key;
+	node.mapped() = CachedPair();
+	return m_cachedPairs.insert(std::move(node)).position->second;
+}
+
+void ContactPairCache::BeginStep(const Broadphase2D& _broadphase)
+{
+	m_uCurrentStep++;
+	m_uReusedPairs = 0;
+
+	const std::vector<BroadphasePair>& pairs = _broadphase.GetCandidatePairs();
+	const uint32_t numberOfPairs = static_cast<uint32_t>(pairs.size());
+
+	m_stepPairs.resize(numberOfPairs);
+	m_isPairReusable.assign(numberOfPairs, 0);
+	m_cachedPairs.reserve(numberOfPairs);
+
+	for (uint32_t i = 0; i < numberOfPairs; i++)
+	{
+		const BroadphaseBody& first = _broadphase.GetBody(pairs[i].m_uFirst);
+		const BroadphaseBody& second = _broadphase.GetBody(pairs[i].m_uSecond);
+
+		bool isNewPair;
+		CachedPair& cachedPair = FindOrCreatePair(GetKey(first, second), isNewPair);
+
+		// Pairs that were not reported in the previous step have already been forgotten, so existing entries hold the previous step's state.
+		cachedPair.m_wasTouching = !isNewPair && cachedPair.m_isTouching;
+		cachedPair.m_uLastStep = m_uCurrentStep;
+		m_stepPairs[i] = &cachedPair;
+
+		if (!cachedPair.m_hasResult)
+		{
+			continue;
+		}
+
+		const bool isFirstInKey = first.m_entityId < second.m_entityId;
+		const NarrowphaseShape& firstShape = _broadphase.GetShape(pairs[i].m_uFirst);
+		const NarrowphaseShape& secondShape = _broadphase.GetShape(pairs[i].m_uSecond);
+
+		const NarrowphaseShape& currentFirstShape = isFirstInKey ? firstShape : secondShape;
+		const NarrowphaseShape& currentSecondShape = isFirstInKey ? secondShape : firstShape;
+
+		if (AreShapesEqual(cachedPair.m_firstShape, currentFirstShape) && AreShapesEqual(cachedPair.m_secondShape, currentSecondShape))
+		{
+			m_isPairReusable[i] = 1;
+		}
+		else if (!cachedPair.m_isTouching && cachedPair.m_separation > SEPARATION_TOLERANCE && HaveSameForm(cachedPair.m_firstShape, currentFirstShape) && HaveSameForm(cachedPair.m_secondShape, currentSecondShape)
+			&& !_broadphase.IsBodyFast(pairs[i].m_uFirst) && !_broadphase.IsBodyFast(pairs[i].m_uSecond))
+		{
+			// Fast bodies are swept from where they started the step, which this bound doesn't cover.
+			const float movedDistance = (currentFirstShape.m_centre - cachedPair.m_firstShape.m_centre).Length() + (currentSecondShape.m_centre - cachedPair.m_secondShape.m_centre).Length();
+			m_isPairReusable[i] = movedDistance + SEPARATION_TOLERANCE < cachedPair.m_separation;
+		}
+
+		m_uReusedPairs += m_isPairReusable[i];
+	}
+}
+
+void ContactPairCache::StoreResult(uint32_t _uPairIndex, const Broadphase2D& _broadphase, bool _isTouching, const Contact2D* _pContact)
+{
+	const BroadphasePair& pair = _broadphase.GetCandidatePairs()[_uPairIndex];
+	const bool isFirstInKey = _broadphase.GetBody(pair.m_uFirst).m_entityId < _broadphase.GetBody(pair.m_uSecond).m_entityId;
+
+	CachedPair& cachedPair = *m_stepPairs[_uPairIndex];
+	cachedPair.m_firstShape = _broadphase.GetShape(isFirstInKey ? pair.m_uFirst : pair.m_uSecond);
+	cachedPair.m_secondShape = _broadphase.GetShape(isFirstInKey ? pair.m_uSecond : pair.m_uFirst);
+	cachedPair.m_isTouching = _isTouching;
+	cachedPair.m_hasResult = true;
+	cachedPair.m_separation = _isTouching ? 0 : CalculateSeparation(cachedPair.m_firstShape, cachedPair.m_secondShape);
+
+	if (!_isTouching)
+	{
+		return;
+	}
+
+	assert(_pContact != nullptr && "Trying to store a touching pair without its contact.");
+
+	// Contacts found by sweeping depend on the movement of the bodies, not only on their shapes, so they are never reused.
+	cachedPair.m_hasResult = _pContact->m_timeOfImpact >= 1;
+
+	cachedPair.m_contact = *_pContact;
+	if (!isFirstInKey)
+	{
+		std::swap(cachedPair.m_contact.m_entityA, cachedPair.m_contact.m_entityB);
+		std::swap(cachedPair.m_contact.m_uBodyA, cachedPair.m_contact.m_uBodyB);
+		cachedPair.m_contact.m_normal = cachedPair.m_contact.m_normal * -1;
+	}
+}
+
+bool ContactPairCache::GetCachedResult(uint32_t _uPairIndex, const Broadphase2D& _broadphase, Contact2D& _contact) const
+{
+	const CachedPair& cachedPair = *m_stepPairs[_uPairIndex];
+	if (!cachedPair.m_isTouching)
+	{
+		return false;
+	}
+
+	// Body indices change every step, so they are taken from the current pair.
+	const BroadphasePair& pair = _broadphase.GetCandidatePairs()[_uPairIndex];
+	_contact.m_uBodyA = pair.m_uFirst;
+	_contact.m_uBodyB = pair.m_uSecond;
+	_contact.m_entityA = _broadphase.GetBody(pair.m_uFirst).m_entityId;
+	_contact.m_entityB = _broadphase.GetBody(pair.m_uSecond).m_entityId;
+	_contact.m_depth = cachedPair.m_contact.m_depth;
+	_contact.m_timeOfImpact = cachedPair.m_contact.m_timeOfImpact;
+	_contact.m_normal = cachedPair.m_contact.m_entityA == _contact.m_entityA ? cachedPair.m_contact.m_normal : cachedPair.m_contact.m_normal * -1;
+
+	return true;
+}
+
+void ContactPairCache::EndStep(const Broadphase2D& _broadphase)
+{
+	m_events.clear();
+
+	// Events of the reported pairs, in the order of the broadphase.
+	const std::vector<BroadphasePair>& pairs = _broadphase.GetCandidatePairs();
+	for (uint32_t i = 0; i < static_cast<uint32_t>(pairs.size()); i++)
+	{
+		const CachedPair& cachedPair = *m_stepPairs[i];
+		if (!cachedPair.m_isTouching && !cachedPair.m_wasTouching)
+		{
+			continue;
+		}
+
+		const ContactEventType type = !cachedPair.m_isTouching ? ContactEventType::End : cachedPair.m_wasTouching ? ContactEventType::Stay : ContactEventType::Begin;
+		m_events.push_back(ContactEvent{ type, _broadphase.GetBody(pairs[i].m_uFirst).m_entityId, _broadphase.GetBody(pairs[i].m_uSecond).m_entityId });
+	}
+
+	// Pairs that are not candidates anymore stopped touching, or one of their Entities was destroyed.
+	const size_t firstVanishedEvent = m_events.size();
+	for (auto iterator = m_cachedPairs.begin(); iterator != m_cachedPairs.end();)
+	{
+		if (iterator->second.m_uLastStep == m_uCurrentStep)
+		{
+			++iterator;
+			continue;
+		}
+
+		if (iterator->second.m_isTouching)
+		{
+			m_events.push_back(ContactEvent{ ContactEventType::End, iterator->first.m_first, iterator->first.m_second });
+		}
+
+		// Keeping the node for the next new pair. Extracting only invalidates the extracted element.
+		auto nextIterator = std::next(iterator);
+		m_freeNodes.push_back(m_cachedPairs.extract(iterator));
+		iterator = nextIterator;
+	}
+
+	// The iteration order of the map is not deterministic, so these are sorted by Entity IDs.
+	std::sort(m_events.begin() + firstVanishedEvent, m_events.end(), [](const ContactEvent& _a, const ContactEvent& _b)
+		{
+			return PairKey{ _a.m_entityA, _a.m_entityB } < PairKey{ _b.m_entityA, _b.m_entityB };
+		});
+}
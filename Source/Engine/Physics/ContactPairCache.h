@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Broadphase2D.h"
+#include "Contact2D.h"
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// Results of the narrowphase kept from one step to the next, keyed by the pair of Entities.
+/// <para>Most bodies move smoothly, so the candidate pairs of a step are mostly the ones of the previous step. A pair whose two shapes
+/// are exactly the ones it was last tested with reuses that result instead of going through the narrowphase again.
+/// A pair that was apart also keeps its result while its bodies haven't moved, in total, as far as the gap between them was.</para>
+/// <para>Comparing the touching state of every pair with the previous step also gives the begin, stay and end contact events.</para>
+/// </summary>
+class ContactPairCache
+{
+	struct PairKey
+	{
+		EntityID m_first;
+		EntityID m_second;
+
+		inline bool operator==(const PairKey& _other) const { return m_first == _other.m_first && m_second == _other.m_second; };
+		inline bool operator<(const PairKey& _other) const { return m_first < _other.m_first || (m_first == _other.m_first && m_second < _other.m_second); };
+	};
+
+	struct PairKeyHash
+	{
+		size_t operator()(const PairKey& _key) const;
+	};
+
+	struct CachedPair
+	{
+		// Shapes of the Entities of the key when the pair was last tested.
+		NarrowphaseShape m_firstShape;
+		NarrowphaseShape m_secondShape;
+		// Oriented like the key: A is its first Entity.
+		Contact2D m_contact{};
+		// Lower bound of the distance between the shapes when they were apart, 0 or less when they touched.
+		float m_separation{ 0 };
+
+		uint32_t m_uLastStep{ 0 };
+		bool m_isTouching{ false };
+		bool m_wasTouching{ false };
+		bool m_hasResult{ false };
+	};
+
+	typedef std::unordered_map<PairKey, CachedPair, PairKeyHash> CachedPairMap;
+	CachedPairMap m_cachedPairs;
+	// Nodes of forgotten pairs, reused by new pairs instead of allocating new ones.
+	std::vector<CachedPairMap::node_type> m_freeNodes;
+
+	// Per-step state, indexed like the candidate pairs of the broadphase.
+	std::vector<CachedPair*> m_stepPairs;
+	std::vector<unsigned char> m_isPairReusable;
+
+	std::vector<ContactEvent> m_events;
+	uint32_t m_uCurrentStep{ 0 };
+	uint32_t m_uReusedPairs{ 0 };
+
+public:
+	/// <summary>
+	/// Finds the cached entry of every candidate pair of the broadphase, creating the new ones, and decides which pairs can skip the narrowphase.
+	/// </summary>
+	void BeginStep(const Broadphase2D& _broadphase);
+	/// <summary>
+	/// Stores the narrowphase result of a pair that was not reusable. _pContact is only read when the pair touches.
+	/// </summary>
+	void StoreResult(uint32_t _uPairIndex, const Broadphase2D& _broadphase, bool _isTouching, const Contact2D* _pContact);
+	/// <summary>
+	/// Emits the contact events of the step and forgets the pairs that the broadphase didn't report.
+	/// </summary>
+	void EndStep(const Broadphase2D& _broadphase);
+
+	inline bool IsPairReusable(uint32_t _uPairIndex) const { return m_isPairReusable[_uPairIndex]; };
+	/// <summary>
+	/// Result of a reusable pair, oriented like the current candidate pair. Returns whether it touches; _contact is only filled when it does.
+	/// </summary>
+	bool GetCachedResult(uint32_t _uPairIndex, const Broadphase2D& _broadphase, Contact2D& _contact) const;
+
+	inline const std::vector<ContactEvent>& GetEvents() const { return m_events; };
+	inline uint32_t HowManyCachedPairs() const { return static_cast<uint32_t>(m_cachedPairs.size()); };
+	// Candidate pairs of the current step that skip the narrowphase.
+	inline uint32_t HowManyReusedPairs() const { return m_uReusedPairs; };
+
+private:
+	static PairKey GetKey(const BroadphaseBody& _first, const BroadphaseBody& _second);
+	CachedPair& FindOrCreatePair(const PairKey& _key, bool& _isNewPair);
+};
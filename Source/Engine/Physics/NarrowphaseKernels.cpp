@@ -0,0 +1,163 @@
+#include "NarrowphaseKernels.h"
+#include "Engine/Components/Transform/C_Transform2D.h"
+#include "Engine/Components/Collision/C_Collider2D.h"
+#include "Engine/Util/Math/MyMath.h"
+#include "Engine/Util/Math/SimdLanes.h"
+#include <assert.h>
+#include <cmath>
+
+namespace
+{
+	using namespace SIMD;
+
+	template<typename Lanes>
+	inline uint32_t CircleCircleLanes(const NarrowphaseBatch& _batch, uint32_t _uLane)
+	{
+		const Lanes dx = Lanes::Load(&_batch.m_bCentreX[_uLane]) - Lanes::Load(&_batch.m_aCentreX[_uLane]);
+		const Lanes dy = Lanes::Load(&_batch.m_bCentreY[_uLane]) - Lanes::Load(&_batch.m_aCentreY[_uLane]);
+		const Lanes radii = Lanes::Load(&_batch.m_aHalfX[_uLane]) + Lanes::Load(&_batch.m_bHalfX[_uLane]);
+
+		return LessMask(dx * dx + dy * dy, radii * radii);
+	}
+
+	template<typename Lanes>
+	inline uint32_t BoxCircleLanes(const NarrowphaseBatch& _batch, uint32_t _uLane)
+	{
+		const Lanes dx = Lanes::Load(&_batch.m_bCentreX[_uLane]) - Lanes::Load(&_batch.m_aCentreX[_uLane]);
+		const Lanes dy = Lanes::Load(&_batch.m_bCentreY[_uLane]) - Lanes::Load(&_batch.m_aCentreY[_uLane]);
+		const Lanes cosA = Lanes::Load(&_batch.m_aCos[_uLane]);
+		const Lanes sinA = Lanes::Load(&_batch.m_aSin[_uLane]);
+
+		// Circle centre in the space of the box. The axes of the box are (cos, -sin) and (sin, cos), matching vec2::RotateBy.
+		const Lanes localX = dx * cosA - dy * sinA;
+		const Lanes localY = dx * sinA + dy * cosA;
+
+		// Distance from the box to the centre along each axis, 0 inside.
+		const Lanes zero = Lanes::Set(0);
+		const Lanes outsideX = Max(Abs(localX) - Lanes::Load(&_batch.m_aHalfX[_uLane]), zero);
+		const Lanes outsideY = Max(Abs(localY) - Lanes::Load(&_batch.m_aHalfY[_uLane]), zero);
+		const Lanes radius = Lanes::Load(&_batch.m_bHalfX[_uLane]);
+
+		return LessMask(outsideX * outsideX + outsideY * outsideY, radius * radius);
+	}
+
+	template<typename Lanes>
+	inline uint32_t BoxBoxLanes(const NarrowphaseBatch& _batch, uint32_t _uLane)
+	{
+		const Lanes dx = Lanes::Load(&_batch.m_bCentreX[_uLane]) - Lanes::Load(&_batch.m_aCentreX[_uLane]);
+		const Lanes dy = Lanes::Load(&_batch.m_bCentreY[_uLane]) - Lanes::Load(&_batch.m_aCentreY[_uLane]);
+		const Lanes cosA = Lanes::Load(&_batch.m_aCos[_uLane]);
+		const Lanes sinA = Lanes::Load(&_batch.m_aSin[_uLane]);
+		const Lanes cosB = Lanes::Load(&_batch.m_bCos[_uLane]);
+		const Lanes sinB = Lanes::Load(&_batch.m_bSin[_uLane]);
+		const Lanes halfAX = Lanes::Load(&_batch.m_aHalfX[_uLane]);
+		const Lanes halfAY = Lanes::Load(&_batch.m_aHalfY[_uLane]);
+		const Lanes halfBX = Lanes::Load(&_batch.m_bHalfX[_uLane]);
+		const Lanes halfBY = Lanes::Load(&_batch.m_bHalfY[_uLane]);
+
+		// Dot products between the axes of both boxes. X with X equals Y with Y, and X with Y equals Y with X up to the sign.
+		const Lanes sameAxes = Abs(cosA * cosB + sinA * sinB);
+		const Lanes crossedAxes = Abs(cosA * sinB - sinA * cosB);
+
+		// Projected distance between the centres against the projected radii of both boxes, for each of the 4 axes.
+		uint32_t separated = GreaterOrEqualMask(Abs(dx * cosA - dy * sinA), halfAX + halfBX * sameAxes + halfBY * crossedAxes);
+		separated |= GreaterOrEqualMask(Abs(dx * sinA + dy * cosA), halfAY + halfBX * crossedAxes + halfBY * sameAxes);
+		separated |= GreaterOrEqualMask(Abs(dx * cosB - dy * sinB), halfBX + halfAX * sameAxes + halfAY * crossedAxes);
+		separated |= GreaterOrEqualMask(Abs(dx * sinB + dy * cosB), halfBY + halfAX * crossedAxes + halfAY * sameAxes);
+
+		return ~separated & ((1u << Lanes::WIDTH) - 1);
+	}
+
+	template<uint32_t(*SimdKernel)(const NarrowphaseBatch&, uint32_t), uint32_t(*ScalarKernel)(const NarrowphaseBatch&, uint32_t)>
+	void RunKernel(NarrowphaseBatch& _batch, uint32_t _uBegin, uint32_t _uEnd)
+	{
+		assert(_uBegin % NARROWPHASE::LANES_PER_MASK_BYTE == 0 && "Narrowphase kernels must start at the first lane of a byte of the hit mask.");
+		assert(_uEnd <= _batch.Size() && _batch.m_hitMask.size() * NARROWPHASE::LANES_PER_MASK_BYTE >= _batch.Size() && "The hit mask of the batch wasn't prepared.");
+
+		uint32_t lane = _uBegin;
+
+#if defined(SIMD_USE_AVX) || defined(SIMD_USE_SSE2)
+		for (; lane + SimdLanes::WIDTH <= _uEnd; lane += SimdLanes::WIDTH)
+		{
+			_batch.m_hitMask[lane >> 3] |= static_cast<uint8_t>(SimdKernel(_batch, lane) << (lane & 7));
+		}
+#endif
+
+		for (; lane < _uEnd; lane++)
+		{
+			_batch.m_hitMask[lane >> 3] |= static_cast<uint8_t>(ScalarKernel(_batch, lane) << (lane & 7));
+		}
+	}
+}
+
+void NarrowphaseBatch::Clear()
+{
+	for (std::vector<float>* values : { &m_aCentreX, &m_aCentreY, &m_aHalfX, &m_aHalfY, &m_aCos, &m_aSin,
+		&m_bCentreX, &m_bCentreY, &m_bHalfX, &m_bHalfY, &m_bCos, &m_bSin })
+	{
+		values->clear();
+	}
+	m_pairIndices.clear();
+	m_hitMask.clear();
+}
+
+void NarrowphaseBatch::Add(const NarrowphaseShape& _a, const NarrowphaseShape& _b, uint32_t _uPairIndex)
+{
+	m_aCentreX.push_back(_a.m_centre.x);
+	m_aCentreY.push_back(_a.m_centre.y);
+	m_aHalfX.push_back(_a.m_halfExtents.x);
+	m_aHalfY.push_back(_a.m_halfExtents.y);
+	m_aCos.push_back(_a.m_cos);
+	m_aSin.push_back(_a.m_sin);
+
+	m_bCentreX.push_back(_b.m_centre.x);
+	m_bCentreY.push_back(_b.m_centre.y);
+	m_bHalfX.push_back(_b.m_halfExtents.x);
+	m_bHalfY.push_back(_b.m_halfExtents.y);
+	m_bCos.push_back(_b.m_cos);
+	m_bSin.push_back(_b.m_sin);
+
+	m_pairIndices.push_back(_uPairIndex);
+}
+
+void NarrowphaseBatch::PrepareHitMask()
+{
+	m_hitMask.assign((Size() + NARROWPHASE::LANES_PER_MASK_BYTE - 1) / NARROWPHASE::LANES_PER_MASK_BYTE, 0);
+}
+
+NarrowphaseShape NARROWPHASE::CalculateShape(const C_Collider2D& _collider, const C_Transform2D& _transform)
+{
+	NarrowphaseShape shape;
+	shape.m_centre = _transform.m_pos + _collider.m_Offset;
+	shape.m_halfExtents = (_collider.m_Dimensions * _transform.m_scale).Absolute() / 2;
+	shape.m_isCircle = _collider.GetCollisionType() == C_Collider2D::CollisionType_2D::circle;
+
+	if (shape.m_isCircle)
+	{
+		// Deformed circles use the X-value of their radius, like in CheckOverlap.
+		shape.m_halfExtents.y = shape.m_halfExtents.x;
+	}
+	else if (_transform.m_rotation != 0)
+	{
+		const double radians = _transform.m_rotation * MyMath::DegreesToRad;
+		shape.m_cos = static_cast<float>(std::cos(radians));
+		shape.m_sin = static_cast<float>(std::sin(radians));
+	}
+
+	return shape;
+}
+
+void NARROWPHASE::TestCircleCircle(NarrowphaseBatch& _batch, uint32_t _uBegin, uint32_t _uEnd)
+{
+	RunKernel<&CircleCircleLanes<WideLanes>, &CircleCircleLanes<ScalarLanes>>(_batch, _uBegin, _uEnd);
+}
+
+void NARROWPHASE::TestBoxCircle(NarrowphaseBatch& _batch, uint32_t _uBegin, uint32_t _uEnd)
+{
+	RunKernel<&BoxCircleLanes<WideLanes>, &BoxCircleLanes<ScalarLanes>>(_batch, _uBegin, _uEnd);
+}
+
+void NARROWPHASE::TestBoxBox(NarrowphaseBatch& _batch, uint32_t _uBegin, uint32_t _uEnd)
+{
+	RunKernel<&BoxBoxLanes<WideLanes>, &BoxBoxLanes<ScalarLanes>>(_batch, _uBegin, _uEnd);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Engine/DataTypes/Vectors/vector2d.h"
+#include <cstdint>
+#include <vector>
+
+struct C_Transform2D;
+struct C_Collider2D;
+
+/// <summary>
+/// World-space shape of a collider, ready for the narrowphase: an oriented box, or a circle whose radius is m_halfExtents.x.
+/// The sine and cosine of the rotation are computed once per body and step instead of once per pair.
+/// </summary>
+struct NarrowphaseShape
+{
+	vec2 m_centre{ 0, 0 };
+	vec2 m_halfExtents{ 0, 0 };
+	float m_cos{ 1 };
+	float m_sin{ 0 };
+	bool m_isCircle{ false };
+};
+
+/// <summary>
+/// Structure of arrays with one lane per pair of shapes. Every kernel reads whole lanes, so the pairs of a batch must all be of the same kind.
+/// Pairs that mix a box and a circle always store the box as A.
+/// </summary>
+struct NarrowphaseBatch
+{
+	std::vector<float> m_aCentreX, m_aCentreY, m_aHalfX, m_aHalfY, m_aCos, m_aSin;
+	std::vector<float> m_bCentreX, m_bCentreY, m_bHalfX, m_bHalfY, m_bCos, m_bSin;
+	// Index of the broadphase pair of every lane.
+	std::vector<uint32_t> m_pairIndices;
+	// Bit i is set when the shapes of lane i overlap.
+	std::vector<uint8_t> m_hitMask;
+
+	void Clear();
+	void Add(const NarrowphaseShape& _a, const NarrowphaseShape& _b, uint32_t _uPairIndex);
+	/// <summary>
+	/// Clears the hit mask. Must be called after the last Add and before running a kernel.
+	/// </summary>
+	void PrepareHitMask();
+
+	inline uint32_t Size() const { return static_cast<uint32_t>(m_pairIndices.size()); };
+	inline bool IsHit(uint32_t _uLane) const { return (m_hitMask[_uLane >> 3] >> (_uLane & 7)) & 1; };
+};
+
+/// <summary>
+/// Batched overlap tests. Each kernel tests the lanes [_uBegin, _uEnd) of a batch, 8 at a time with AVX or 4 at a time with SSE2,
+/// and writes their bits of the hit mask. _uBegin must be a multiple of 8, so threads working on different ranges never share a byte of the mask.
+/// <para>The tests are strict, like C_Collider2D::CheckOverlap: shapes that only touch don't overlap.</para>
+/// </summary>
+namespace NARROWPHASE
+{
+	static constexpr uint32_t LANES_PER_MASK_BYTE{ 8 };
+
+	NarrowphaseShape CalculateShape(const C_Collider2D& _collider, const C_Transform2D& _transform);
+
+	void TestCircleCircle(NarrowphaseBatch& _batch, uint32_t _uBegin, uint32_t _uEnd);
+	// A is the box, B is the circle.
+	void TestBoxCircle(NarrowphaseBatch& _batch, uint32_t _uBegin, uint32_t _uEnd);
+	// Separating axis test on the two axes of each box.
+	void TestBoxBox(NarrowphaseBatch& _batch, uint32_t _uBegin, uint32_t _uEnd);
+}
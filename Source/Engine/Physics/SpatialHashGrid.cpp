@@ -0,0 +1,166 @@
+#include "SpatialHashGrid.h"
+#include <algorithm>
+#include <cmath>
+
+int32_t SpatialHashGrid::GetCellCoordinate(float _position) const
+{
+	return static_cast<int32_t>(std::floor(_position * m_inverseCellSize));
+}
+
+uint32_t SpatialHashGrid::GetBucket(int32_t _cellX, int32_t _cellY) const
+{
+	// Big primes from "Optimized Spatial Hashing for Collision Detection of Deformable Objects" (Teschner et al., 2003).
+	const uint32_t hash = (static_cast<uint32_t>(_cellX) * 73856093u) ^ (static_cast<uint32_t>(_cellY) * 19349663u);
+	return hash & m_uBucketMask;
+}
+
+float SpatialHashGrid::CalculateCellSize(const AABB2D* _pBounds, uint32_t _uNumberOfBodies)
+{
+	if (_uNumberOfBodies == 0)
+	{
+		return 1;
+	}
+
+	double totalSize = 0;
+	for (uint32_t i = 0; i < _uNumberOfBodies; i++)
+	{
+		const vec2 size = _pBounds[i].GetSize();
+		totalSize += std::max(size.x, size.y);
+	}
+
+	return std::max(1.0f, static_cast<float>(totalSize / _uNumberOfBodies) * CELL_SIZE_PER_BODY_SIZE);
+}
+
+void SpatialHashGrid::Build(const AABB2D* _pBounds, uint32_t _uNumberOfBodies, float _cellSize)
+{
+	m_pBounds = _pBounds;
+	m_uNumberOfBodies = _uNumberOfBodies;
+
+	m_cellSize = _cellSize > 0 ? _cellSize : CalculateCellSize(_pBounds, _uNumberOfBodies);
+	m_inverseCellSize = 1.0f / m_cellSize;
+
+	m_unsortedEntries.clear();
+	m_oversizedBodies.clear();
+	m_isBodyOversized.assign(_uNumberOfBodies, false);
+
+	for (uint32_t i = 0; i < _uNumberOfBodies; i++)
+	{
+		const int32_t minCellX = GetCellCoordinate(_pBounds[i].m_min.x);
+		const int32_t minCellY = GetCellCoordinate(_pBounds[i].m_min.y);
+		const int32_t maxCellX = GetCellCoordinate(_pBounds[i].m_max.x);
+		const int32_t maxCellY = GetCellCoordinate(_pBounds[i].m_max.y);
+
+		const int64_t numberOfCells = (static_cast<int64_t>(maxCellX) - minCellX + 1) * (static_cast<int64_t>(maxCellY) - minCellY + 1);
+		if (numberOfCells > MAX_CELLS_PER_BODY)
+		{
+			m_oversizedBodies.push_back(i);
+			m_isBodyOversized[i] = true;
+			continue;
+		}
+
+		for (int32_t cellY = minCellY; cellY <= maxCellY; cellY++)
+		{
+			for (int32_t cellX = minCellX; cellX <= maxCellX; cellX++)
+			{
+				m_unsortedEntries.push_back(CellEntry{ i, cellX, cellY });
+			}
+		}
+	}
+
+	// Twice as many buckets as entries keeps hash collisions rare. The extra element closes the last bucket.
+	uint32_t numberOfBuckets = 16;
+	while (numberOfBuckets < m_unsortedEntries.size() * 2)
+	{
+		numberOfBuckets <<= 1;
+	}
+	m_bucketStarts.assign(numberOfBuckets + 1, 0);
+	m_uBucketMask = numberOfBuckets - 1;
+
+	// Counting sort of the entries by bucket. It keeps the order of the bodies inside every bucket.
+	m_entryBuckets.resize(m_unsortedEntries.size());
+	for (size_t i = 0; i < m_unsortedEntries.size(); i++)
+	{
+		m_entryBuckets[i] = GetBucket(m_unsortedEntries[i].m_cellX, m_unsortedEntries[i].m_cellY);
+		m_bucketStarts[m_entryBuckets[i] + 1]++;
+	}
+	for (uint32_t bucket = 0; bucket < numberOfBuckets; bucket++)
+	{
+		m_bucketStarts[bucket + 1] += m_bucketStarts[bucket];
+	}
+
+	m_entries.resize(m_unsortedEntries.size());
+	for (size_t i = 0; i < m_unsortedEntries.size(); i++)
+	{
+		// Using the start of the next bucket as a write cursor, so after the loop it has moved back to the start of its own bucket.
+		m_entries[m_bucketStarts[m_entryBuckets[i]]++] = m_unsortedEntries[i];
+	}
+	for (uint32_t bucket = numberOfBuckets; bucket > 0; bucket--)
+	{
+		m_bucketStarts[bucket] = m_bucketStarts[bucket - 1];
+	}
+	m_bucketStarts[0] = 0;
+}
+
+void SpatialHashGrid::FindPairs(std::vector<BroadphasePair>& _pairs, const CollisionFilter* _pFilters) const
+{
+	auto canCollide = [_pFilters](uint32_t _uFirstBody, uint32_t _uSecondBody)
+		{
+			return _pFilters == nullptr || _pFilters[_uFirstBody].CanCollideWith(_pFilters[_uSecondBody]);
+		};
+
+	const uint32_t numberOfBuckets = static_cast<uint32_t>(m_bucketStarts.size()) - 1;
+
+	for (uint32_t bucket = 0; bucket < numberOfBuckets; bucket++)
+	{
+		const uint32_t bucketEnd = m_bucketStarts[bucket + 1];
+
+		for (uint32_t first = m_bucketStarts[bucket]; first < bucketEnd; first++)
+		{
+			const CellEntry& firstEntry = m_entries[first];
+			const AABB2D& firstBounds = m_pBounds[firstEntry.m_uBody];
+
+			for (uint32_t second = first + 1; second < bucketEnd; second++)
+			{
+				const CellEntry& secondEntry = m_entries[second];
+
+				// Different cells that share a bucket.
+				if (firstEntry.m_cellX != secondEntry.m_cellX || firstEntry.m_cellY != secondEntry.m_cellY || !canCollide(firstEntry.m_uBody, secondEntry.m_uBody))
+				{
+					continue;
+				}
+
+				const AABB2D& secondBounds = m_pBounds[secondEntry.m_uBody];
+				if (!firstBounds.Overlaps(secondBounds))
+				{
+					continue;
+				}
+
+				// Only the cell that holds the minimum corner of the overlap reports the pair.
+				if (GetCellCoordinate(std::max(firstBounds.m_min.x, secondBounds.m_min.x)) != firstEntry.m_cellX
+					|| GetCellCoordinate(std::max(firstBounds.m_min.y, secondBounds.m_min.y)) != firstEntry.m_cellY)
+				{
+					continue;
+				}
+
+				_pairs.push_back(BroadphasePair{ std::min(firstEntry.m_uBody, secondEntry.m_uBody), std::max(firstEntry.m_uBody, secondEntry.m_uBody) });
+			}
+		}
+	}
+
+	// Oversized bodies are few and big, so they are tested against every other body.
+	for (uint32_t oversizedBody : m_oversizedBodies)
+	{
+		const AABB2D& oversizedBounds = m_pBounds[oversizedBody];
+
+		for (uint32_t body = 0; body < m_uNumberOfBodies; body++)
+		{
+			// Two oversized bodies are only reported by the first one.
+			if (body == oversizedBody || (m_isBodyOversized[body] && body < oversizedBody) || !canCollide(oversizedBody, body) || !oversizedBounds.Overlaps(m_pBounds[body]))
+			{
+				continue;
+			}
+
+			_pairs.push_back(BroadphasePair{ std::min(oversizedBody, body), std::max(oversizedBody, body) });
+		}
+	}
+}
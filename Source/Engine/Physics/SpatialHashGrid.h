@@ -0,0 +1,76 @@
+#pragma once
+
+#include "AABB2D.h"
+#include "CollisionFilter.h"
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// Pair of bodies whose bounds overlap, as indices into the array of bounds given to the broadphase. m_uFirst is always the smaller one.
+/// </summary>
+struct BroadphasePair
+{
+	uint32_t m_uFirst;
+	uint32_t m_uSecond;
+};
+
+/// <summary>
+/// Uniform grid stored as a hash table of cells, rebuilt from scratch every step.
+/// <para>Bodies are bucketed with a counting sort into flat arrays, so building the grid doesn't allocate once the arrays have grown.
+/// A pair is only reported by the cell that holds the corner of the overlap of both bounds, so bodies that share several cells are reported once.
+/// Bodies that would cover too many cells are kept out of the grid and tested against everyone instead.</para>
+/// </summary>
+class SpatialHashGrid
+{
+public:
+	// Bodies covering more cells than this are too big for the grid.
+	static constexpr unsigned int MAX_CELLS_PER_BODY{ 16 };
+	// The cell is this many times the average size of a body, so most bodies only touch one to four cells.
+	static constexpr float CELL_SIZE_PER_BODY_SIZE{ 2.0f };
+
+private:
+	struct CellEntry
+	{
+		uint32_t m_uBody;
+		int32_t m_cellX;
+		int32_t m_cellY;
+	};
+
+	float m_cellSize{ 1 };
+	float m_inverseCellSize{ 1 };
+
+	// Hash table of cells. The entries of bucket b are m_entries[m_bucketStarts[b], m_bucketStarts[b + 1]).
+	std::vector<uint32_t> m_bucketStarts;
+	uint32_t m_uBucketMask{ 0 };
+	std::vector<CellEntry> m_entries;
+	std::vector<uint32_t> m_oversizedBodies;
+	std::vector<bool> m_isBodyOversized;
+
+	// Scratch memory of Build.
+	std::vector<CellEntry> m_unsortedEntries;
+	std::vector<uint32_t> m_entryBuckets;
+
+	const AABB2D* m_pBounds{ nullptr };
+	uint32_t m_uNumberOfBodies{ 0 };
+
+public:
+	/// <summary>
+	/// Buckets the bounds in the grid. _pBounds must stay alive until the pairs are found.
+	/// With _cellSize 0 or less, the cell size is tuned to the size of the bodies.
+	/// </summary>
+	void Build(const AABB2D* _pBounds, uint32_t _uNumberOfBodies, float _cellSize = 0);
+	/// <summary>
+	/// Appends every pair of overlapping bounds to _pairs. The order only depends on the order of the bounds given to Build.
+	/// <para>With _pFilters, one per body, pairs that can't collide are rejected before their bounds are compared.</para>
+	/// </summary>
+	void FindPairs(std::vector<BroadphasePair>& _pairs, const CollisionFilter* _pFilters = nullptr) const;
+
+	inline float GetCellSize() const { return m_cellSize; };
+	inline unsigned int HowManyOversizedBodies() const { return static_cast<unsigned int>(m_oversizedBodies.size()); };
+
+	static float CalculateCellSize(const AABB2D* _pBounds, uint32_t _uNumberOfBodies);
+
+private:
+	inline int32_t GetCellCoordinate(float _position) const;
+	inline uint32_t GetBucket(int32_t _cellX, int32_t _cellY) const;
+};
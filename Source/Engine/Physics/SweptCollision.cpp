@@ -0,0 +1,307 @@
+#include "SweptCollision.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+	inline AABB2D GetShapeBounds(const NarrowphaseShape& _shape, const vec2& _centre)
+	{
+		const vec2 extents(std::abs(_shape.m_cos) * _shape.m_halfExtents.x + std::abs(_shape.m_sin) * _shape.m_halfExtents.y,
+			std::abs(_shape.m_sin) * _shape.m_halfExtents.x + std::abs(_shape.m_cos) * _shape.m_halfExtents.y);
+		return AABB2D{ _centre - extents, _centre + extents };
+	}
+
+	inline AABB2D Inflate(const AABB2D& _box, const vec2& _amount)
+	{
+		return AABB2D{ _box.m_min - _amount, _box.m_max + _amount };
+	}
+
+	// Moves _position by _movement inside [_low, _high], bouncing on both ends as many times as it takes, and points _velocity the way
+	// it ends up moving. Positions left behind the movement, or ranges the shape doesn't fit in, are clamped instead. Returns whether it bounced.
+	bool FoldIntoRange(float& _position, float _movement, float _low, float _high, float& _velocity)
+	{
+		const float end = _position + _movement;
+		const float range = _high - _low;
+		const bool isPastEnd = (_movement > 0 && end > _high) || (_movement < 0 && end < _low);
+		if (!isPastEnd || range <= 0)
+		{
+			_position = std::max(std::min(end, _high), _low);
+			return false;
+		}
+
+		// Bouncing between both ends repeats every two ranges: the first one goes forwards, the second one comes back mirrored.
+		float unfolded = std::fmod(end - _low, 2 * range);
+		if (unfolded < 0)
+		{
+			unfolded += 2 * range;
+		}
+
+		const bool isComingBack = unfolded > range;
+		_position = _low + (isComingBack ? 2 * range - unfolded : unfolded);
+		_velocity = std::abs(_velocity) * ((_movement > 0) != isComingBack ? 1.0f : -1.0f);
+		return true;
+	}
+
+	// Normal of the side of the box closest to the point, for shapes that already overlap.
+	vec2 GetClosestSideNormal(const vec2& _point, const AABB2D& _box)
+	{
+		const float toLeft = _point.x - _box.m_min.x;
+		const float toRight = _box.m_max.x - _point.x;
+		const float toTop = _point.y - _box.m_min.y;
+		const float toBottom = _box.m_max.y - _point.y;
+		const float closestSide = std::min(std::min(toLeft, toRight), std::min(toTop, toBottom));
+
+		if (closestSide == toLeft) { return vec2(-1, 0); }
+		if (closestSide == toRight) { return vec2(1, 0); }
+		if (closestSide == toTop) { return vec2(0, -1); }
+		return vec2(0, 1);
+	}
+}
+
+bool SWEPT::SweepPointAABB(const vec2& _point, const AABB2D& _box, const vec2& _displacement, float& _toi, vec2& _normal)
+{
+	// Slab test: the point is inside the box while it is inside both of its slabs.
+	const float start[2] = { _point.x, _point.y };
+	const float displacement[2] = { _displacement.x, _displacement.y };
+	const float boxMin[2] = { _box.m_min.x, _box.m_min.y };
+	const float boxMax[2] = { _box.m_max.x, _box.m_max.y };
+
+	float enter = 0;
+	float exit = 1;
+	int enterAxis = -1;
+
+	for (int axis = 0; axis < 2; axis++)
+	{
+		if (displacement[axis] == 0)
+		{
+			if (start[axis] <= boxMin[axis] || start[axis] >= boxMax[axis])
+			{
+				return false;
+			}
+			continue;
+		}
+
+		float slabEnter = (boxMin[axis] - start[axis]) / displacement[axis];
+		float slabExit = (boxMax[axis] - start[axis]) / displacement[axis];
+		if (slabEnter > slabExit)
+		{
+			std::swap(slabEnter, slabExit);
+		}
+
+		if (slabEnter > enter)
+		{
+			enter = slabEnter;
+			enterAxis = axis;
+		}
+		exit = std::min(exit, slabExit);
+
+		if (enter >= exit)
+		{
+			return false;
+		}
+	}
+
+	_toi = enter;
+	if (enterAxis == 0)
+	{
+		_normal = vec2(displacement[0] > 0 ? -1.0f : 1.0f, 0);
+	}
+	else if (enterAxis == 1)
+	{
+		_normal = vec2(0, displacement[1] > 0 ? -1.0f : 1.0f);
+	}
+	else
+	{
+		_normal = GetClosestSideNormal(_point, _box);
+	}
+
+	return true;
+}
+
+bool SWEPT::SweepCircleCircle(const vec2& _centre, float _radius, const vec2& _obstacleCentre, float _obstacleRadius, const vec2& _displacement, float& _toi, vec2& _normal)
+{
+	// Ray from the centre against a circle with the radius of both.
+	const vec2 offset = _centre - _obstacleCentre;
+	const float radius = _radius + _obstacleRadius;
+	const float c = offset.Dot(offset) - radius * radius;
+
+	if (c < 0)
+	{
+		const float distance = offset.Length();
+		_toi = 0;
+		_normal = distance > 0 ? offset / distance : vec2(0, 1);
+		return true;
+	}
+
+	const float a = _displacement.Dot(_displacement);
+	const float b = offset.Dot(_displacement);
+	if (a == 0 || b >= 0)
+	{
+		return false;
+	}
+
+	const float discriminant = b * b - a * c;
+	if (discriminant < 0)
+	{
+		return false;
+	}
+
+	const float toi = (-b - std::sqrt(discriminant)) / a;
+	if (toi > 1)
+	{
+		return false;
+	}
+
+	_toi = std::max(toi, 0.0f);
+	_normal = (offset + _displacement * _toi) / radius;
+	return true;
+}
+
+bool SWEPT::SweepCircleAABB(const vec2& _centre, float _radius, const AABB2D& _box, const vec2& _displacement, float& _toi, vec2& _normal)
+{
+	const vec2 closestPoint(std::clamp(_centre.x, _box.m_min.x, _box.m_max.x), std::clamp(_centre.y, _box.m_min.y, _box.m_max.y));
+	const vec2 toCentre = _centre - closestPoint;
+	const float distance = toCentre.Length();
+
+	if (distance < _radius)
+	{
+		_toi = 0;
+		_normal = distance > 0 ? toCentre / distance : GetClosestSideNormal(_centre, _box);
+		return true;
+	}
+
+	// The centre against the box grown by the radius, with rounded corners.
+	float toi;
+	vec2 normal;
+	if (!SweepPointAABB(_centre, Inflate(_box, vec2(_radius, _radius)), _displacement, toi, normal))
+	{
+		return false;
+	}
+
+	const vec2 impactPoint = _centre + _displacement * toi;
+	const bool isOutsideX = impactPoint.x < _box.m_min.x || impactPoint.x > _box.m_max.x;
+	const bool isOutsideY = impactPoint.y < _box.m_min.y || impactPoint.y > _box.m_max.y;
+
+	if (isOutsideX && isOutsideY)
+	{
+		// Entering through a corner of the grown box. It can only hit the rounded corner, which is a circle around the corner of the box.
+		const vec2 corner(impactPoint.x < _box.m_min.x ? _box.m_min.x : _box.m_max.x, impactPoint.y < _box.m_min.y ? _box.m_min.y : _box.m_max.y);
+		return SweepCircleCircle(_centre, _radius, corner, 0, _displacement, _toi, _normal);
+	}
+
+	_toi = toi;
+	_normal = normal;
+	return true;
+}
+
+bool SWEPT::SweepAABBAABB(const AABB2D& _box, const AABB2D& _obstacle, const vec2& _displacement, float& _toi, vec2& _normal)
+{
+	const vec2 halfSize = _box.GetSize() / 2;
+	const vec2 centre = _box.m_min + halfSize;
+	const AABB2D grownObstacle = Inflate(_obstacle, halfSize);
+
+	if (centre.x > grownObstacle.m_min.x && centre.x < grownObstacle.m_max.x && centre.y > grownObstacle.m_min.y && centre.y < grownObstacle.m_max.y)
+	{
+		_toi = 0;
+		_normal = GetClosestSideNormal(centre, grownObstacle);
+		return true;
+	}
+
+	return SweepPointAABB(centre, grownObstacle, _displacement, _toi, _normal);
+}
+
+bool SWEPT::SweepShapes(const NarrowphaseShape& _a, const vec2& _displacementA, const NarrowphaseShape& _b, const vec2& _displacementB, float& _toi, vec2& _normal)
+{
+	// Moving A relative to B, from where both started the step.
+	const vec2 startA = _a.m_centre - _displacementA;
+	const vec2 startB = _b.m_centre - _displacementB;
+	const vec2 displacement = _displacementA - _displacementB;
+
+	if (_a.m_isCircle && _b.m_isCircle)
+	{
+		return SweepCircleCircle(startA, _a.m_halfExtents.x, startB, _b.m_halfExtents.x, displacement, _toi, _normal);
+	}
+
+	if (_a.m_isCircle)
+	{
+		return SweepCircleAABB(startA, _a.m_halfExtents.x, GetShapeBounds(_b, startB), displacement, _toi, _normal);
+	}
+
+	if (_b.m_isCircle)
+	{
+		// Sweeping the circle against the box instead, which is the same movement seen from the other side.
+		if (!SweepCircleAABB(startB, _b.m_halfExtents.x, GetShapeBounds(_a, startA), displacement * -1, _toi, _normal))
+		{
+			return false;
+		}
+		_normal = _normal * -1;
+		return true;
+	}
+
+	return SweepAABBAABB(GetShapeBounds(_a, startA), GetShapeBounds(_b, startB), displacement, _toi, _normal);
+}
+
+bool SWEPT::SweepInsideBounds(const vec2& _centre, const vec2& _halfExtents, const AABB2D& _area, const vec2& _displacement, float& _toi, vec2& _normal)
+{
+	bool hasImpact = false;
+	_toi = std::numeric_limits<float>::max();
+
+	auto testWall = [&](float _position, float _movement, float _wall, const vec2& _wallNormal)
+		{
+			// Shapes that are already past the wall and keep going away from the area hit it straight away.
+			const float toi = std::max((_wall - _position) / _movement, 0.0f);
+			if (toi <= 1 && toi < _toi)
+			{
+				_toi = toi;
+				_normal = _wallNormal;
+				hasImpact = true;
+			}
+		};
+
+	if (_displacement.x > 0) { testWall(_centre.x, _displacement.x, _area.m_max.x - _halfExtents.x, vec2(-1, 0)); }
+	else if (_displacement.x < 0) { testWall(_centre.x, _displacement.x, _area.m_min.x + _halfExtents.x, vec2(1, 0)); }
+
+	if (_displacement.y > 0) { testWall(_centre.y, _displacement.y, _area.m_max.y - _halfExtents.y, vec2(0, -1)); }
+	else if (_displacement.y < 0) { testWall(_centre.y, _displacement.y, _area.m_min.y + _halfExtents.y, vec2(0, 1)); }
+
+	return hasImpact;
+}
+
+bool SWEPT::BounceInsideBounds(vec2& _centre, const vec2& _halfExtents, const AABB2D& _area, const vec2& _displacement, vec2& _velocity)
+{
+	vec2 remaining = _displacement;
+	bool hasBounced = false;
+
+	for (unsigned int i = 0; i < MAX_SUBSTEPS; i++)
+	{
+		float toi;
+		vec2 normal;
+		if (!SweepInsideBounds(_centre, _halfExtents, _area, remaining, toi, normal))
+		{
+			break;
+		}
+
+		// Moving up to the wall and reflecting the rest of the movement. Walls are axis-aligned, so only one component flips.
+		_centre = _centre + remaining * toi;
+		remaining = remaining * (1 - toi);
+
+		if (normal.x != 0)
+		{
+			remaining.x *= -1;
+			_velocity.x = std::abs(_velocity.x) * normal.x;
+		}
+		else
+		{
+			remaining.y *= -1;
+			_velocity.y = std::abs(_velocity.y) * normal.y;
+		}
+
+		hasBounced = true;
+	}
+
+	// Whatever is left after MAX_SUBSTEPS impacts is folded per axis, so the shape always ends inside the area however long the movement is.
+	const bool hasBouncedX = FoldIntoRange(_centre.x, remaining.x, _area.m_min.x + _halfExtents.x, _area.m_max.x - _halfExtents.x, _velocity.x);
+	const bool hasBouncedY = FoldIntoRange(_centre.y, remaining.y, _area.m_min.y + _halfExtents.y, _area.m_max.y - _halfExtents.y, _velocity.y);
+	return hasBounced || hasBouncedX || hasBouncedY;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "AABB2D.h"
+#include "NarrowphaseKernels.h"
+
+/// <summary>
+/// Time of impact queries for shapes moving in a straight line during a step, so fast bodies and long steps don't tunnel through each other.
+/// <para>Every query moves the first shape by _displacement while the obstacle stays still. When they touch before the end of the movement,
+/// _toi gets the fraction of the movement where they do, between 0 and 1, and _normal the unit normal of the obstacle at that point,
+/// pointing towards the moving shape. Shapes that already overlap at the start report a time of impact of 0.</para>
+/// </summary>
+namespace SWEPT
+{
+	// Most impacts a moving shape sweeps one by one in a single step when bouncing. The movement left after them is folded instead,
+	// so a shape that doesn't fit its area can't loop forever.
+	static constexpr unsigned int MAX_SUBSTEPS{ 4 };
+
+	bool SweepPointAABB(const vec2& _point, const AABB2D& _box, const vec2& _displacement, float& _toi, vec2& _normal);
+	bool SweepCircleCircle(const vec2& _centre, float _radius, const vec2& _obstacleCentre, float _obstacleRadius, const vec2& _displacement, float& _toi, vec2& _normal);
+	bool SweepCircleAABB(const vec2& _centre, float _radius, const AABB2D& _box, const vec2& _displacement, float& _toi, vec2& _normal);
+	bool SweepAABBAABB(const AABB2D& _box, const AABB2D& _obstacle, const vec2& _displacement, float& _toi, vec2& _normal);
+
+	/// <summary>
+	/// Sweeps two narrowphase shapes given at the end of the step, where each of them arrived after moving by its displacement.
+	/// _normal points from B towards A. Rotated boxes are swept as their bounds, so their impacts are conservative.
+	/// </summary>
+	bool SweepShapes(const NarrowphaseShape& _a, const vec2& _displacementA, const NarrowphaseShape& _b, const vec2& _displacementB, float& _toi, vec2& _normal);
+
+	/// <summary>
+	/// Time of impact of a shape moving inside an area against the walls of the area. _normal points inwards.
+	/// </summary>
+	bool SweepInsideBounds(const vec2& _centre, const vec2& _halfExtents, const AABB2D& _area, const vec2& _displacement, float& _toi, vec2& _normal);
+	/// <summary>
+	/// Moves _centre by _displacement inside the area, reflecting the movement and _velocity on every wall it reaches on the way.
+	/// It always ends inside the area, or clamped to it on the axes the shape doesn't fit in. Returns whether it bounced.
+	/// </summary>
+	bool BounceInsideBounds(vec2& _centre, const vec2& _halfExtents, const AABB2D& _area, const vec2& _displacement, vec2& _velocity);
+}
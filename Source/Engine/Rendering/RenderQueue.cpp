@@ -0,0 +1,133 @@
+#include "RenderQueue.h"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+
+void RenderQueue::BeginBuild(unsigned int _uNumberOfThreads)
+{
+	if (m_threadCommandLists.size() < _uNumberOfThreads)
+	{
+		m_threadCommandLists.resize(_uNumberOfThreads);
+	}
+
+	// Clearing keeps the capacity of the lists, so a stable scene doesn't allocate every frame.
+	for (CommandList& commandList : m_threadCommandLists)
+	{
+		commandList.m_commands.clear();
+	}
+	m_commands.clear();
+	m_texts.clear();
+}
+
+void RenderQueue::EndBuild()
+{
+	size_t numberOfCommands = 0;
+	for (const CommandList& commandList : m_threadCommandLists)
+	{
+		numberOfCommands += commandList.m_commands.size();
+	}
+
+	m_commands.reserve(numberOfCommands);
+	for (const CommandList& commandList : m_threadCommandLists)
+	{
+		m_commands.insert(m_commands.end(), commandList.m_commands.begin(), commandList.m_commands.end());
+	}
+
+	std::sort(m_commands.begin(), m_commands.end(), [](const RenderCommand& _first, const RenderCommand& _second)
+		{
+			if (_first.m_layer != _second.m_layer)
+			{
+				return _first.m_layer < _second.m_layer;
+			}
+			return _first.m_orderKey < _second.m_orderKey;
+		});
+}
+
+void RenderQueue::AddText(int _x, int _y, TPixel _color, const char* _format, ...)
+{
+	RenderText& text = m_texts.emplace_back(RenderText{ _x, _y, _color });
+
+	va_list arguments;
+	va_start(arguments, _format);
+	va_list argumentsCopy;
+	va_copy(argumentsCopy, arguments);
+	const int length = vsnprintf(nullptr, 0, _format, argumentsCopy);
+	va_end(argumentsCopy);
+
+	if (length > 0)
+	{
+		text.m_text.resize(static_cast<size_t>(length));
+		vsnprintf(text.m_text.data(), text.m_text.size() + 1, _format, arguments);
+	}
+	va_end(arguments);
+}
+
+void RenderQueue::Submit(Tigr* _pTarget) const
+{
+	if (_pTarget == nullptr)
+	{
+		return;
+	}
+
+	for (const RenderCommand& command : m_commands)
+	{
+		SubmitCommand(_pTarget, command);
+	}
+
+	for (const RenderText& text : m_texts)
+	{
+		tigrPrint(_pTarget, tfont, text.m_x, text.m_y, text.m_color, "%s", text.m_text.c_str());
+	}
+}
+
+void RenderQueue::SubmitCommand(Tigr* _pTarget, const RenderCommand& _Command)
+{
+	tigrBlitTint(_pTarget, _Command.m_pTexture, _Command.m_destinationX, _Command.m_destinationY,
+		_Command.m_sourceX, _Command.m_sourceY, _Command.m_sourceWidth, _Command.m_sourceHeight, _Command.m_tint);
+}
+
+void RenderQueue::ReleaseTexture(Tigr* _pTexture)
+{
+	if (_pTexture == nullptr)
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(ReleasedTexturesMutex);
+		if (DeferTextureReleases)
+		{
+			ReleasedTextures.push_back(_pTexture);
+			return;
+		}
+	}
+
+	tigrFree(_pTexture);
+}
+
+void RenderQueue::FlushReleasedTextures()
+{
+	std::vector<Tigr*> texturesToFree;
+	{
+		std::lock_guard<std::mutex> lock(ReleasedTexturesMutex);
+		texturesToFree.swap(ReleasedTextures);
+	}
+
+	for (Tigr* texture : texturesToFree)
+	{
+		tigrFree(texture);
+	}
+}
+
+void RenderQueue::SetDeferTextureReleases(bool _defer)
+{
+	{
+		std::lock_guard<std::mutex> lock(ReleasedTexturesMutex);
+		DeferTextureReleases = _defer;
+	}
+
+	if (!_defer)
+	{
+		FlushReleasedTextures();
+	}
+}
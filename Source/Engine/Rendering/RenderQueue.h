@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Engine/ExternalLibraries/Tigr/tigr.h"
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// A single blit, with everything needed to draw it without touching the Components that produced it.
+/// </summary>
+struct RenderCommand
+{
+	Tigr* m_pTexture{ nullptr };
+
+	int m_destinationX{ 0 };
+	int m_destinationY{ 0 };
+
+	int m_sourceX{ 0 };
+	int m_sourceY{ 0 };
+	int m_sourceWidth{ 0 };
+	int m_sourceHeight{ 0 };
+
+	TPixel m_tint{ 255, 255, 255, 255 };
+
+	int m_layer{ 0 }; // Lower layers are drawn first.
+	uint64_t m_orderKey{ 0 }; // Sorts the commands of the same layer, so the final order doesn't depend on which thread built each command.
+};
+
+/// <summary>
+/// A line of text printed with the default font, formatted when it is added so it keeps the values of the frame it belongs to.
+/// </summary>
+struct RenderText
+{
+	int m_x{ 0 };
+	int m_y{ 0 };
+	TPixel m_color{ 255, 255, 255, 255 };
+	std::string m_text;
+};
+
+/// <summary>
+/// Draw commands of a frame. They are built in parallel into one list per JobSystem thread,
+/// then merged and sorted by layer and order key so they are always submitted in the same order.
+/// </summary>
+class RenderQueue
+{
+	struct alignas(64) CommandList
+	{
+		std::vector<RenderCommand> m_commands;
+	};
+
+	std::vector<CommandList> m_threadCommandLists;
+	std::vector<RenderCommand> m_commands;
+	// Drawn on top of every command. Only added from the main thread.
+	std::vector<RenderText> m_texts;
+
+	// Textures released while a queue could still be drawing them.
+	static inline std::mutex ReleasedTexturesMutex;
+	static inline std::vector<Tigr*> ReleasedTextures;
+	static inline bool DeferTextureReleases{ false };
+
+public:
+	/// <summary>
+	/// Clears the previous frame. Every thread that builds commands needs its own list.
+	/// </summary>
+	void BeginBuild(unsigned int _uNumberOfThreads);
+	inline std::vector<RenderCommand>& GetThreadCommandList(unsigned int _uThreadIndex) { return m_threadCommandLists[_uThreadIndex].m_commands; };
+	/// <summary>
+	/// Merges the lists of every thread and sorts them by layer and order key.
+	/// </summary>
+	void EndBuild();
+	/// <summary>
+	/// Adds a printf-style line of text, drawn over the commands of the same queue.
+	/// </summary>
+	void AddText(int _x, int _y, TPixel _color, const char* _format, ...);
+
+	void Submit(Tigr* _pTarget) const;
+	static void SubmitCommand(Tigr* _pTarget, const RenderCommand& _Command);
+
+	inline const std::vector<RenderCommand>& GetCommands() const { return m_commands; };
+	inline const std::vector<RenderText>& GetTexts() const { return m_texts; };
+
+	/// <summary>
+	/// Frees a texture that Render Commands may point to. While releases are deferred, the texture is kept alive until FlushReleasedTextures,
+	/// since a queue built before the release could still be drawing it on another thread.
+	/// </summary>
+	static void ReleaseTexture(Tigr* _pTexture);
+	/// <summary>
+	/// Frees every deferred texture. Must only be called when no queue is being submitted.
+	/// </summary>
+	static void FlushReleasedTextures();
+	/// <summary>
+	/// Turning the deferral off flushes the textures released so far.
+	/// </summary>
+	static void SetDeferTextureReleases(bool _defer);
+};
@@ -0,0 +1,110 @@
+#include "S_RigidbodyIntegration.h"
+#include "Engine/ECS/ECS_PoolManager.h"
+#include "Engine/Jobs/JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+void S_RigidbodyIntegration::Update(ECS_PoolManager* _PoolManager, float _deltaTime)
+{
+	_PoolManager->ParallelForEach<C_Transform2D, C_Rigidbody2D>([_deltaTime](C_Transform2D& _transform, C_Rigidbody2D& _rigidbody)
+		{
+			_rigidbody.UpdatePhysics(_transform, _deltaTime);
+		}, BATCH_SIZE);
+}
+
+void S_RigidbodyIntegration::RunBenchmark()
+{
+	static constexpr unsigned int BODY_COUNTS[]{ 1000, 10000, 100000, 1000000 };
+	// Every measurement integrates about this many bodies in total, so the small counts run enough steps to be timed.
+	static constexpr unsigned int BODIES_PER_MEASUREMENT{ 20000000 };
+	static constexpr float DELTA_TIME{ 1.0f / 60 };
+
+	// 0 workers runs every Job on the main thread, then it doubles up to one worker per hardware thread besides the main one.
+	const unsigned int maxWorkers = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+	std::vector<unsigned int> workerCounts{ 0 };
+	for (unsigned int workers = 1; workers < maxWorkers; workers *= 2)
+	{
+		workerCounts.push_back(workers);
+	}
+	workerCounts.push_back(maxWorkers);
+
+	ECS_PoolManager* poolManager = ECS_PoolManager::InitManager();
+	// The registration is never committed, so the benchmark Pool is not saved into the Pool Information files of the game.
+	poolManager->BeginPoolRegistration();
+	const PoolID poolId = poolManager->CreateEntityPool<C_Transform2D, C_Rigidbody2D>(BODY_COUNTS[std::size(BODY_COUNTS) - 1], std::string("Integration_Benchmark_Pool"));
+	ECS_EntityPool* pool = poolManager->GetEntityPool(poolId);
+
+	S_RigidbodyIntegration system;
+	std::vector<EntityID> entities;
+	std::vector<C_Transform2D> initialTransforms;
+	std::vector<C_Rigidbody2D> initialRigidbodies;
+	std::vector<vec2> serialPositions;
+
+	printf("Rigidbody integration benchmark (%u hardware threads)\n", std::thread::hardware_concurrency());
+	printf("%10s %8s %12s %8s %12s\n", "Bodies", "Workers", "ms/step", "Speedup", "Same result");
+
+	for (const unsigned int bodyCount : BODY_COUNTS)
+	{
+		// Growing the Pool up to the next count. Velocities and gravity vary between bodies, like the bubbles of the game.
+		for (unsigned int i = static_cast<unsigned int>(entities.size()); i < bodyCount; i++)
+		{
+			const EntityID entity = poolManager->CreateEntityWithComponents<C_Transform2D, C_Rigidbody2D>(poolId);
+			C_Rigidbody2D* rigidbody = pool->GetComponent<C_Rigidbody2D>(entity);
+			rigidbody->m_velocity = vec2(static_cast<float>(i % 97) - 48, static_cast<float>(i % 89) - 44);
+			rigidbody->m_gravityScale = (i % 3) * 0.5f;
+			entities.push_back(entity);
+
+			initialTransforms.push_back(*pool->GetComponent<C_Transform2D>(entity));
+			initialRigidbodies.push_back(*rigidbody);
+		}
+
+		const unsigned int steps = std::max(BODIES_PER_MEASUREMENT / bodyCount, 1u);
+
+		// Runs the steps from the same initial state every time, and returns the milliseconds per step.
+		auto measure = [&]()
+			{
+				for (unsigned int i = 0; i < bodyCount; i++)
+				{
+					*pool->GetComponent<C_Transform2D>(entities[i]) = initialTransforms[i];
+					*pool->GetComponent<C_Rigidbody2D>(entities[i]) = initialRigidbodies[i];
+				}
+
+				const auto start = std::chrono::steady_clock::now();
+				for (unsigned int step = 0; step < steps; step++)
+				{
+					system.Update(poolManager, DELTA_TIME);
+				}
+				return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / steps;
+			};
+
+		// Without a JobSystem, ParallelForEach runs on the calling thread: this is the serial path.
+		const double serialMilliseconds = measure();
+		serialPositions.resize(bodyCount);
+		for (unsigned int i = 0; i < bodyCount; i++)
+		{
+			serialPositions[i] = pool->GetComponent<C_Transform2D>(entities[i])->m_pos;
+		}
+		printf("%10u %8s %12.4f %8.2f %12s\n", bodyCount, "serial", serialMilliseconds, 1.0, "-");
+
+		for (const unsigned int workers : workerCounts)
+		{
+			JobSystem::InitJobSystem(workers);
+			const double milliseconds = measure();
+			JobSystem::DestroyInstance();
+
+			bool isSameResult = true;
+			for (unsigned int i = 0; i < bodyCount && isSameResult; i++)
+			{
+				const vec2& position = pool->GetComponent<C_Transform2D>(entities[i])->m_pos;
+				isSameResult = position.x == serialPositions[i].x && position.y == serialPositions[i].y;
+			}
+
+			printf("%10u %8u %12.4f %8.2f %12s\n", bodyCount, workers, milliseconds, serialMilliseconds / milliseconds, isSameResult ? "yes" : "NO");
+		}
+	}
+
+	ECS_PoolManager::DestroyInstance();
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Engine/ECS/ECS_Interfaces.h"
+#include "Engine/ECS/ECS_SystemScheduler.h"
+#include "Engine/Components/Transform/C_Transform2D.h"
+#include "Engine/Components/Rigidbody/C_RigidBody2D.h"
+
+/// <summary>
+/// Moves every Entity with a Transform and a Rigidbody according to its velocity, drag and gravity.
+/// <para>Each body only touches its own Transform and Rigidbody, so the bodies are integrated in batches on the worker threads.
+/// The result is the same as integrating them one after the other.</para>
+/// </summary>
+struct S_RigidbodyIntegration : IECS_System
+{
+	// Integrating a body takes a few nanoseconds, so batches have to be big for a Job to be worth it.
+	static constexpr unsigned int BATCH_SIZE{ 1024 };
+
+	using Reads = ECS_ComponentList<>;
+	using Writes = ECS_ComponentList<C_Transform2D, C_Rigidbody2D>;
+
+	void Update(ECS_PoolManager* _PoolManager, float _deltaTime);
+
+	/// <summary>
+	/// Prints the milliseconds per step of this System for 1k to 1M bodies, from 0 workers up to one per hardware thread, and checks that
+	/// every worker count ends with the same positions as the serial run. It creates its own Pool Manager and JobSystem, so it must run
+	/// instead of the Engine: see CONFIG_ENGINE_RUN_INTEGRATION_BENCHMARK.
+	/// </summary>
+	static void RunBenchmark();
+};
@@ -0,0 +1,191 @@
+#include "S_WorldBounds.h"
+#include "Engine/ECS/ECS_PoolManager.h"
+#include "Engine/Physics/SweptCollision.h"
+#include "Engine/Util/Math/SimdLanes.h"
+#include <algorithm>
+
+namespace
+{
+	using namespace SIMD;
+
+	static_assert(S_WorldBounds::LANES_PER_CHUNK % WideLanes::WIDTH == 0, "Chunks must be made of whole SIMD registers.");
+
+	struct BoundsChunk
+	{
+		static constexpr unsigned int LANES{ S_WorldBounds::LANES_PER_CHUNK };
+
+		alignas(32) float m_centreX[LANES];
+		alignas(32) float m_centreY[LANES];
+		alignas(32) float m_halfX[LANES];
+		alignas(32) float m_halfY[LANES];
+		alignas(32) float m_velocityX[LANES];
+		alignas(32) float m_velocityY[LANES];
+		alignas(32) float m_minX[LANES];
+		alignas(32) float m_minY[LANES];
+		alignas(32) float m_maxX[LANES];
+		alignas(32) float m_maxY[LANES];
+		// 1 for reflect, 0 for clamp.
+		alignas(32) float m_reflect[LANES];
+		// Reflecting lanes that move further than their room in a step, which could bounce more than once.
+		bool m_isLongStep[LANES];
+
+		C_Transform2D* m_pTransforms[LANES];
+		const C_Collider2D* m_pColliders[LANES];
+		C_Rigidbody2D* m_pRigidbodies[LANES];
+		unsigned int m_uSize{ 0 };
+	};
+
+	// Constrains one axis of the lanes starting at _uLane.
+	template<typename Lanes>
+	inline void ConstrainAxis(float* _pCentre, float* _pVelocity, const float* _pHalf, const float* _pMin, const float* _pMax, const float* _pReflect, unsigned int _uLane)
+	{
+		const Lanes centre = Lanes::Load(&_pCentre[_uLane]);
+		const Lanes velocity = Lanes::Load(&_pVelocity[_uLane]);
+		const Lanes half = Lanes::Load(&_pHalf[_uLane]);
+		const Lanes zero = Lanes::Set(0);
+
+		// Range of the centre that keeps the whole collider inside.
+		const Lanes low = Lanes::Load(&_pMin[_uLane]) + half;
+		const Lanes high = Lanes::Load(&_pMax[_uLane]) - half;
+
+		// Past an edge and still moving away from the bounds. Only these are folded back and have their velocity flipped.
+		const Lanes pastHigh = CompareGreater(centre, high) & CompareGreater(velocity, zero);
+		const Lanes pastLow = CompareLess(centre, low) & CompareLess(velocity, zero);
+
+		// Reflecting folds the overshoot back inside, where the Entity would be had it bounced exactly on the edge, and flips the velocity to point inwards.
+		// The centre is always kept between both edges, so Entities left outside without moving away, like ones spawned off-screen, are pulled in too.
+		const Lanes foldedCentre = Select(pastHigh, high + high - centre, Select(pastLow, low + low - centre, centre));
+		const Lanes reflectedCentre = Max(Min(foldedCentre, high), low);
+		const Lanes speed = Abs(velocity);
+		const Lanes reflectedVelocity = Select(pastHigh, zero - speed, Select(pastLow, speed, velocity));
+
+		// Clamping holds the Entity against the edge, and drops the velocity that pushes it outwards.
+		const Lanes clampedCentre = Max(Min(centre, high), low);
+		const Lanes clampedVelocity = Select(pastHigh | pastLow, zero, velocity);
+
+		const Lanes isReflect = CompareGreater(Lanes::Load(&_pReflect[_uLane]), zero);
+		Select(isReflect, reflectedCentre, clampedCentre).Store(&_pCentre[_uLane]);
+		Select(isReflect, reflectedVelocity, clampedVelocity).Store(&_pVelocity[_uLane]);
+	}
+
+	void ConstrainChunk(BoundsChunk& _chunk, float _deltaTime)
+	{
+		// The unused lanes of the last register are zeroed instead of running a scalar tail. Their results are never written back.
+		const unsigned int paddedSize = (_chunk.m_uSize + WideLanes::WIDTH - 1) / WideLanes::WIDTH * WideLanes::WIDTH;
+		for (unsigned int lane = _chunk.m_uSize; lane < paddedSize; lane++)
+		{
+			for (float* column : { _chunk.m_centreX, _chunk.m_centreY, _chunk.m_halfX, _chunk.m_halfY, _chunk.m_velocityX, _chunk.m_velocityY,
+				_chunk.m_minX, _chunk.m_minY, _chunk.m_maxX, _chunk.m_maxY, _chunk.m_reflect })
+			{
+				column[lane] = 0;
+			}
+		}
+
+		for (unsigned int lane = 0; lane < paddedSize; lane += WideLanes::WIDTH)
+		{
+			ConstrainAxis<WideLanes>(_chunk.m_centreX, _chunk.m_velocityX, _chunk.m_halfX, _chunk.m_minX, _chunk.m_maxX, _chunk.m_reflect, lane);
+			ConstrainAxis<WideLanes>(_chunk.m_centreY, _chunk.m_velocityY, _chunk.m_halfY, _chunk.m_minY, _chunk.m_maxY, _chunk.m_reflect, lane);
+		}
+
+		for (unsigned int lane = 0; lane < _chunk.m_uSize; lane++)
+		{
+			if (_chunk.m_isLongStep[lane])
+			{
+				// Folding the overshoot once isn't enough for these, so they are swept from where they started the step instead,
+				// bouncing on every edge they reach on the way. Like the other lanes, they end between low and high.
+				// The start of the step relies on the integration order documented where the System is registered (Engine::Init).
+				// The Components still hold the values the chunk was gathered from.
+				C_Transform2D* transform = _chunk.m_pTransforms[lane];
+				C_Rigidbody2D* rigidbody = _chunk.m_pRigidbodies[lane];
+				const vec2 displacement = rigidbody->m_velocity * _deltaTime;
+				const AABB2D area{ vec2(_chunk.m_minX[lane], _chunk.m_minY[lane]), vec2(_chunk.m_maxX[lane], _chunk.m_maxY[lane]) };
+
+				const vec2 halfExtents(_chunk.m_halfX[lane], _chunk.m_halfY[lane]);
+				const vec2 low = area.m_min + halfExtents;
+				const vec2 high = area.m_max - halfExtents;
+
+				vec2 centre = transform->m_pos + _chunk.m_pColliders[lane]->m_Offset - displacement;
+				SWEPT::BounceInsideBounds(centre, halfExtents, area, displacement, rigidbody->m_velocity);
+				centre = vec2(std::max(std::min(centre.x, high.x), low.x), std::max(std::min(centre.y, high.y), low.y));
+				transform->m_pos = centre - _chunk.m_pColliders[lane]->m_Offset;
+				continue;
+			}
+
+			_chunk.m_pTransforms[lane]->m_pos = vec2(_chunk.m_centreX[lane], _chunk.m_centreY[lane]) - _chunk.m_pColliders[lane]->m_Offset;
+			_chunk.m_pRigidbodies[lane]->m_velocity = vec2(_chunk.m_velocityX[lane], _chunk.m_velocityY[lane]);
+		}
+
+		_chunk.m_uSize = 0;
+	}
+}
+
+void S_WorldBounds::Update(ECS_PoolManager* _PoolManager, float _deltaTime)
+{
+	if (!ECS::HaveComponentsBeenInitialized<C_Transform2D, C_Collider2D, C_Rigidbody2D, C_BoundsConstraint>())
+	{
+		return;
+	}
+
+	PoolComponentMask mask;
+	ECS::SetPoolComponentMask<C_Transform2D, C_Collider2D, C_Rigidbody2D, C_BoundsConstraint>(mask);
+
+	const AABB2D screenBounds = m_screenBounds;
+	_PoolManager->ParallelForEachRange(mask, [&screenBounds, _deltaTime](ECS_EntityPool& _EntityPool, unsigned int _uBegin, unsigned int _uEnd, const EntityComponentMask& _entityMask)
+		{
+			const ECS_ComponentPool* transformPool = _EntityPool.m_componentPools[_EntityPool.GetComponentIndex<C_Transform2D>()];
+			const ECS_ComponentPool* colliderPool = _EntityPool.m_componentPools[_EntityPool.GetComponentIndex<C_Collider2D>()];
+			const ECS_ComponentPool* rigidbodyPool = _EntityPool.m_componentPools[_EntityPool.GetComponentIndex<C_Rigidbody2D>()];
+			const ECS_ComponentPool* constraintPool = _EntityPool.m_componentPools[_EntityPool.GetComponentIndex<C_BoundsConstraint>()];
+
+			BoundsChunk chunk;
+			for (unsigned int entityIndex = _uBegin; entityIndex < _uEnd; entityIndex++)
+			{
+				if (!_EntityPool.HasComponentsEnabled(entityIndex, _entityMask))
+				{
+					continue;
+				}
+
+				C_Transform2D* transform = reinterpret_cast<C_Transform2D*>(transformPool->GetElement(entityIndex));
+				const C_Collider2D* collider = reinterpret_cast<const C_Collider2D*>(colliderPool->GetElement(entityIndex));
+				C_Rigidbody2D* rigidbody = reinterpret_cast<C_Rigidbody2D*>(rigidbodyPool->GetElement(entityIndex));
+				const C_BoundsConstraint* constraint = reinterpret_cast<const C_BoundsConstraint*>(constraintPool->GetElement(entityIndex));
+
+				// The world AABB is centred on the collider, and already covers its scale and rotation.
+				const vec2 centre = transform->m_pos + collider->m_Offset;
+				const vec2 halfExtents = collider->GetWorldAABB(*transform).GetSize() / 2;
+				const AABB2D& bounds = constraint->m_useScreenBounds ? screenBounds : constraint->m_bounds;
+
+				const unsigned int lane = chunk.m_uSize++;
+				chunk.m_centreX[lane] = centre.x;
+				chunk.m_centreY[lane] = centre.y;
+				chunk.m_halfX[lane] = halfExtents.x;
+				chunk.m_halfY[lane] = halfExtents.y;
+				chunk.m_velocityX[lane] = rigidbody->m_velocity.x;
+				chunk.m_velocityY[lane] = rigidbody->m_velocity.y;
+				chunk.m_minX[lane] = bounds.m_min.x;
+				chunk.m_minY[lane] = bounds.m_min.y;
+				chunk.m_maxX[lane] = bounds.m_max.x;
+				chunk.m_maxY[lane] = bounds.m_max.y;
+				chunk.m_reflect[lane] = constraint->m_behaviour == C_BoundsConstraint::BoundsBehaviour::reflect ? 1.0f : 0.0f;
+
+				// The Integration moved the Entity by a whole step of its velocity. Clamping is exact however far that is.
+				const vec2 displacement = rigidbody->m_velocity * _deltaTime;
+				const vec2 room = bounds.GetSize() - halfExtents * 2;
+				chunk.m_isLongStep[lane] = chunk.m_reflect[lane] > 0 && (std::abs(displacement.x) > room.x || std::abs(displacement.y) > room.y);
+
+				chunk.m_pTransforms[lane] = transform;
+				chunk.m_pColliders[lane] = collider;
+				chunk.m_pRigidbodies[lane] = rigidbody;
+
+				if (chunk.m_uSize == BoundsChunk::LANES)
+				{
+					ConstrainChunk(chunk, _deltaTime);
+				}
+			}
+
+			if (chunk.m_uSize > 0)
+			{
+				ConstrainChunk(chunk, _deltaTime);
+			}
+		}, BATCH_SIZE);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Engine/ECS/ECS_Interfaces.h"
+#include "Engine/ECS/ECS_SystemScheduler.h"
+#include "Engine/Components/Transform/C_Transform2D.h"
+#include "Engine/Components/Collision/C_Collider2D.h"
+#include "Engine/Components/Collision/C_BoundsConstraint.h"
+#include "Engine/Components/Rigidbody/C_RigidBody2D.h"
+#include "Engine/Physics/AABB2D.h"
+
+/// <summary>
+/// Keeps every Entity with a Transform, a Collider, a Rigidbody and a Bounds Constraint inside its bounds, reflecting or clamping it on the edges.
+/// <para>Entities are gathered in chunks of columns (centre, half extents, velocity and bounds, one lane per Entity) and every chunk is constrained
+/// by a branchless SIMD kernel, then written back. Each Entity only touches its own Components, so the chunks run on the worker threads.</para>
+/// <para>Reflecting Entities that move further in a step than the room they have inside their bounds are swept from the start of the step
+/// instead, so they bounce on every edge they reach.</para>
+/// </summary>
+struct S_WorldBounds : IECS_System
+{
+	static constexpr unsigned int BATCH_SIZE{ 1024 };
+	// Lanes of the columns of a chunk, kept on the stack. A multiple of the widest SIMD register.
+	static constexpr unsigned int LANES_PER_CHUNK{ 64 };
+
+	using Reads = ECS_ComponentList<C_Collider2D, C_BoundsConstraint>;
+	using Writes = ECS_ComponentList<C_Transform2D, C_Rigidbody2D>;
+
+	S_WorldBounds(const AABB2D& _screenBounds) : m_screenBounds{ _screenBounds } {};
+
+	void Update(ECS_PoolManager* _PoolManager, float _deltaTime);
+
+private:
+	AABB2D m_screenBounds;
+};
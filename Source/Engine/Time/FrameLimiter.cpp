@@ -0,0 +1,315 @@
+#include "FrameLimiter.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <timeapi.h>
+#pragma comment(lib, "winmm.lib")
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#else
+#include <cerrno>
+#include <time.h>
+#endif
+
+namespace
+{
+	constexpr double NanosecondsPerSecond{ 1'000'000'000.0 };
+
+	// Percentile of the first _uCount values, which are reordered.
+	float Percentile(float* _values, unsigned int _uCount, double _percentile)
+	{
+		if (_uCount == 0)
+		{
+			return 0;
+		}
+
+		const unsigned int index = std::min(_uCount - 1, static_cast<unsigned int>(_percentile * _uCount));
+		std::nth_element(_values, _values + index, _values + _uCount);
+		return _values[index];
+	}
+}
+
+#pragma region Frame Limiter General Methods
+
+FrameLimiter::FrameLimiter()
+{
+#ifdef _WIN32
+	// High resolution timers need Windows 10 1803. Older versions fall back to Sleep with a 1 ms timer resolution.
+	m_pWaitableTimer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+#endif
+}
+
+FrameLimiter::~FrameLimiter()
+{
+#ifdef _WIN32
+	if (m_pWaitableTimer != nullptr)
+	{
+		CloseHandle(m_pWaitableTimer);
+		m_pWaitableTimer = nullptr;
+	}
+#endif
+}
+
+void FrameLimiter::Init(FrameLimitMode _mode, float _baseFPS)
+{
+	m_mode = _baseFPS > 0 ? _mode : FrameLimitMode::Unlimited;
+	m_baseFPS = _baseFPS;
+	m_uAdaptiveDivisor = 1;
+
+	m_frameStart = 0;
+	m_nextDeadline = 0;
+	m_currentFrameTime = -1;
+	m_uHistoryCount = 0;
+	m_uHistoryNext = 0;
+	m_uFramesSinceEvaluation = 0;
+	m_uMissedDeadlines = 0;
+}
+
+uint64_t FrameLimiter::Now()
+{
+#ifdef _WIN32
+	static const LONGLONG frequency = []() { LARGE_INTEGER value; QueryPerformanceFrequency(&value); return value.QuadPart; }();
+
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+
+	// Splitting the conversion so it doesn't overflow.
+	const uint64_t seconds = static_cast<uint64_t>(counter.QuadPart / frequency);
+	const uint64_t remainder = static_cast<uint64_t>(counter.QuadPart % frequency);
+	return seconds * 1'000'000'000ull + remainder * 1'000'000'000ull / static_cast<uint64_t>(frequency);
+#else
+	timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return static_cast<uint64_t>(time.tv_sec) * 1'000'000'000ull + static_cast<uint64_t>(time.tv_nsec);
+#endif
+}
+
+#pragma endregion
+
+#pragma region Frames
+
+double FrameLimiter::BeginFrame()
+{
+	const uint64_t now = Now();
+
+	if (m_frameStart == 0)
+	{
+		m_frameStart = now;
+		m_nextDeadline = now;
+		return 0;
+	}
+
+	const double frameTime = (now - m_frameStart) / NanosecondsPerSecond;
+	m_frameStart = now;
+	m_currentFrameTime = static_cast<float>(frameTime);
+
+	return frameTime;
+}
+
+void FrameLimiter::EndFrame()
+{
+	if (m_frameStart == 0)
+	{
+		return;
+	}
+
+	const uint64_t now = Now();
+
+	if (m_currentFrameTime >= 0)
+	{
+		m_frameTimes[m_uHistoryNext] = m_currentFrameTime;
+		m_workTimes[m_uHistoryNext] = static_cast<float>((now - m_frameStart) / NanosecondsPerSecond);
+		m_uHistoryNext = (m_uHistoryNext + 1) % HISTORY_SIZE;
+		m_uHistoryCount = std::min(m_uHistoryCount + 1, HISTORY_SIZE);
+	}
+
+	if (m_mode == FrameLimitMode::Unlimited)
+	{
+		return;
+	}
+
+	if (m_mode == FrameLimitMode::Adaptive && ++m_uFramesSinceEvaluation >= ADAPTIVE_EVALUATION_FRAMES)
+	{
+		UpdateAdaptiveTarget();
+		m_uFramesSinceEvaluation = 0;
+	}
+
+	// Deadlines are chained instead of counted from the start of the frame, so waking up late doesn't make the frame rate drift.
+	m_nextDeadline += static_cast<uint64_t>(NanosecondsPerSecond / GetTargetFPS());
+
+	if (now >= m_nextDeadline)
+	{
+		m_uMissedDeadlines++;
+		m_nextDeadline = now;
+		return;
+	}
+
+	WaitUntil(m_nextDeadline);
+}
+
+double FrameLimiter::GetTimeSinceBeginningOfFrame() const
+{
+	return m_frameStart == 0 ? 0 : (Now() - m_frameStart) / NanosecondsPerSecond;
+}
+
+float FrameLimiter::GetTargetFPS() const
+{
+	switch (m_mode)
+	{
+	case FrameLimitMode::Limited:
+		return m_baseFPS;
+	case FrameLimitMode::Adaptive:
+		return m_baseFPS / m_uAdaptiveDivisor;
+	default:
+		return 0;
+	}
+}
+
+void FrameLimiter::UpdateAdaptiveTarget()
+{
+	float workTimes[HISTORY_SIZE];
+	std::copy_n(m_workTimes, m_uHistoryCount, workTimes);
+	const double p95WorkTime = Percentile(workTimes, m_uHistoryCount, 0.95);
+
+	// Lowest divisor whose frame fits the work. Raising the target needs more headroom than keeping it.
+	unsigned int divisor = 1;
+	for (; divisor < ADAPTIVE_MAX_DIVISOR; divisor++)
+	{
+		const double headroom = divisor < m_uAdaptiveDivisor ? ADAPTIVE_RAISE_HEADROOM : ADAPTIVE_HEADROOM;
+		if (p95WorkTime <= headroom * divisor / m_baseFPS)
+		{
+			break;
+		}
+	}
+
+	m_uAdaptiveDivisor = divisor;
+}
+
+FramePacingStats FrameLimiter::GetStats() const
+{
+	FramePacingStats stats;
+	stats.m_uMissedDeadlines = m_uMissedDeadlines;
+	stats.m_targetFPS = GetTargetFPS();
+
+	const unsigned int numberOfFrames = m_uHistoryCount;
+	if (numberOfFrames == 0)
+	{
+		return stats;
+	}
+	stats.m_uNumberOfFrames = numberOfFrames;
+
+	float frameTimes[HISTORY_SIZE];
+	float workTimes[HISTORY_SIZE];
+	std::copy_n(m_frameTimes, numberOfFrames, frameTimes);
+	std::copy_n(m_workTimes, numberOfFrames, workTimes);
+
+	double frameTimeSum = 0;
+	double workTimeSum = 0;
+	stats.m_minFrameTime = frameTimes[0];
+	stats.m_maxFrameTime = frameTimes[0];
+	for (unsigned int i = 0; i < numberOfFrames; i++)
+	{
+		frameTimeSum += frameTimes[i];
+		workTimeSum += workTimes[i];
+		stats.m_minFrameTime = std::min<double>(stats.m_minFrameTime, frameTimes[i]);
+		stats.m_maxFrameTime = std::max<double>(stats.m_maxFrameTime, frameTimes[i]);
+	}
+	stats.m_averageFrameTime = frameTimeSum / numberOfFrames;
+	stats.m_averageWorkTime = workTimeSum / numberOfFrames;
+
+	double squaredDifferenceSum = 0;
+	for (unsigned int i = 0; i < numberOfFrames; i++)
+	{
+		const double difference = frameTimes[i] - stats.m_averageFrameTime;
+		squaredDifferenceSum += difference * difference;
+	}
+	stats.m_frameTimeStandardDeviation = std::sqrt(squaredDifferenceSum / numberOfFrames);
+
+	stats.m_p50FrameTime = Percentile(frameTimes, numberOfFrames, 0.50);
+	stats.m_p95FrameTime = Percentile(frameTimes, numberOfFrames, 0.95);
+	stats.m_p99FrameTime = Percentile(frameTimes, numberOfFrames, 0.99);
+	stats.m_p95WorkTime = Percentile(workTimes, numberOfFrames, 0.95);
+
+	return stats;
+}
+
+#pragma endregion
+
+#pragma region Waiting
+
+void FrameLimiter::WaitFor(double _seconds)
+{
+	if (_seconds <= 0)
+	{
+		return;
+	}
+
+	WaitUntil(Now() + static_cast<uint64_t>(_seconds * NanosecondsPerSecond));
+}
+
+void FrameLimiter::WaitUntil(uint64_t _deadline)
+{
+	const int64_t spinNanoseconds = std::clamp(static_cast<int64_t>(m_sleepErrorMean + 2 * std::sqrt(m_sleepErrorVariance)), MIN_SPIN_NANOSECONDS, MAX_SPIN_NANOSECONDS);
+
+	const uint64_t sleepDeadline = _deadline - spinNanoseconds;
+	if (Now() < sleepDeadline)
+	{
+		SleepUntil(sleepDeadline);
+
+		// Learning how late the OS wakes us up.
+		const double sleepError = static_cast<double>(static_cast<int64_t>(Now() - sleepDeadline));
+		const double difference = sleepError - m_sleepErrorMean;
+		m_sleepErrorMean += difference / 16;
+		m_sleepErrorVariance += (difference * difference - m_sleepErrorVariance) / 16;
+	}
+
+	while (Now() < _deadline)
+	{
+		std::this_thread::yield();
+	}
+}
+
+void FrameLimiter::SleepUntil(uint64_t _deadline)
+{
+#ifdef _WIN32
+	const uint64_t now = Now();
+	if (now >= _deadline)
+	{
+		return;
+	}
+
+	if (m_pWaitableTimer != nullptr)
+	{
+		// Negative due times are relative, in 100 nanosecond units.
+		LARGE_INTEGER dueTime;
+		dueTime.QuadPart = -static_cast<LONGLONG>((_deadline - now) / 100);
+		if (SetWaitableTimer(m_pWaitableTimer, &dueTime, 0, nullptr, nullptr, FALSE))
+		{
+			WaitForSingleObject(m_pWaitableTimer, INFINITE);
+			return;
+		}
+	}
+
+	// The default timer resolution is around 15.6 ms, far more than the spin margin, so it's raised to 1 ms for the length of the sleep.
+	timeBeginPeriod(1);
+	Sleep(static_cast<DWORD>((_deadline - now) / 1'000'000));
+	timeEndPeriod(1);
+#else
+	timespec deadline;
+	deadline.tv_sec = static_cast<time_t>(_deadline / 1'000'000'000ull);
+	deadline.tv_nsec = static_cast<long>(_deadline % 1'000'000'000ull);
+
+	// Absolute deadlines make the sleep immune to being interrupted by signals.
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR)
+	{
+	}
+#endif
+}
+
+#pragma endregion
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+
+enum class FrameLimitMode : signed char
+{
+	Adaptive = -1,
+	Unlimited = 0,
+	Limited = 1
+};
+
+/// <summary>
+/// Frame times of the last FrameLimiter::HISTORY_SIZE frames, in seconds.
+/// <para>Frame time goes from the beginning of a frame to the beginning of the next one. Work time excludes the time spent waiting for the limiter.</para>
+/// </summary>
+struct FramePacingStats
+{
+	unsigned int m_uNumberOfFrames{ 0 };
+
+	double m_averageFrameTime{ 0 };
+	double m_minFrameTime{ 0 };
+	double m_maxFrameTime{ 0 };
+	double m_p50FrameTime{ 0 };
+	double m_p95FrameTime{ 0 };
+	double m_p99FrameTime{ 0 };
+	double m_frameTimeStandardDeviation{ 0 };
+
+	double m_averageWorkTime{ 0 };
+	double m_p95WorkTime{ 0 };
+
+	unsigned int m_uMissedDeadlines{ 0 }; // Frames whose work took longer than the target frame time, since the limiter started.
+	float m_targetFPS{ 0 };
+};
+
+/// <summary>
+/// Paces the frames on a monotonic clock. Waiting sleeps until shortly before the deadline and spins the rest,
+/// so it's precise without keeping a core busy for the whole frame. The spinning margin adapts to how late the sleeps wake up.
+/// <para>In Adaptive mode, the target is the highest fraction of the base FPS (1/1, 1/2, 1/3...) that fits the 95th percentile of the work time.</para>
+/// </summary>
+class FrameLimiter
+{
+public:
+	static constexpr unsigned int HISTORY_SIZE{ 256 };
+	static constexpr unsigned int ADAPTIVE_EVALUATION_FRAMES{ 120 };
+	static constexpr unsigned int ADAPTIVE_MAX_DIVISOR{ 4 };
+	static constexpr double ADAPTIVE_HEADROOM{ 0.9 }; // Part of the frame the work can use before lowering the target.
+	static constexpr double ADAPTIVE_RAISE_HEADROOM{ 0.75 }; // Stricter, so the target doesn't bounce between two values.
+
+	static constexpr int64_t MIN_SPIN_NANOSECONDS{ 100'000 };
+	static constexpr int64_t MAX_SPIN_NANOSECONDS{ 4'000'000 };
+
+private:
+	FrameLimitMode m_mode{ FrameLimitMode::Unlimited };
+	float m_baseFPS{ 60 };
+	unsigned int m_uAdaptiveDivisor{ 1 };
+
+	uint64_t m_frameStart{ 0 };
+	uint64_t m_nextDeadline{ 0 };
+	float m_currentFrameTime{ -1 }; // Negative during the first frame, which has no previous frame to measure from.
+
+	// Sleep oversleeping, in nanoseconds. Exponential moving average and variance.
+	double m_sleepErrorMean{ 1'000'000 };
+	double m_sleepErrorVariance{ 0 };
+
+	float m_frameTimes[HISTORY_SIZE]{};
+	float m_workTimes[HISTORY_SIZE]{};
+	unsigned int m_uHistoryCount{ 0 };
+	unsigned int m_uHistoryNext{ 0 };
+	unsigned int m_uFramesSinceEvaluation{ 0 };
+	unsigned int m_uMissedDeadlines{ 0 };
+
+	void* m_pWaitableTimer{ nullptr }; // Only used on Windows.
+
+public:
+	FrameLimiter();
+	FrameLimiter(const FrameLimiter&) = delete;
+	FrameLimiter& operator=(const FrameLimiter&) = delete;
+	~FrameLimiter();
+
+	void Init(FrameLimitMode _mode, float _baseFPS);
+
+	/// <summary>
+	/// Marks the beginning of a frame and returns the seconds since the beginning of the previous one (0 for the first frame).
+	/// </summary>
+	double BeginFrame();
+	/// <summary>
+	/// Records the work time of the frame and waits until the frame deadline, depending on the mode.
+	/// </summary>
+	void EndFrame();
+
+	double GetTimeSinceBeginningOfFrame() const;
+	/// <summary>
+	/// Target FPS right now. 0 when Unlimited.
+	/// </summary>
+	float GetTargetFPS() const;
+	inline FrameLimitMode GetMode() const { return m_mode; };
+	FramePacingStats GetStats() const;
+
+	/// <summary>
+	/// Precise wait that doesn't affect the frame deadlines.
+	/// </summary>
+	void WaitFor(double _seconds);
+
+	/// <summary>
+	/// Nanoseconds on a monotonic clock.
+	/// </summary>
+	static uint64_t Now();
+
+private:
+	void WaitUntil(uint64_t _deadline);
+	void SleepUntil(uint64_t _deadline);
+	void UpdateAdaptiveTarget();
+};
@@ -0,0 +1,258 @@
+#include "TimerWheel.h"
+#include "Engine/ECS/ECS_PoolManager.h"
+#include <algorithm>
+#include <assert.h>
+#include <cmath>
+
+TimerWheel::TimerWheel()
+{
+	std::fill(std::begin(m_slots), std::end(m_slots), INVALID_TIMER);
+}
+
+void TimerWheel::SetTickDuration(float _tickDuration)
+{
+	assert(_tickDuration > 0 && "The tick duration of a TimerWheel must be positive.");
+	assert(m_uNumberOfPendingTimers == 0 && "Changing the tick duration of a TimerWheel with pending timers would change when they fire.");
+
+	m_tickDuration = _tickDuration;
+}
+
+#pragma region Timers
+
+TimerHandle TimerWheel::AddTimer(float _seconds, TimerCallback _callback, void* _pUserData)
+{
+	if (_callback == nullptr)
+	{
+		assert(false && "Trying to add a timer without a callback.");
+		return TimerHandle{};
+	}
+
+	const TimerHandle handle = CreateTimer(_seconds, TimerAction::Callback);
+	m_timers[handle.m_uIndex].m_callback = _callback;
+	m_timers[handle.m_uIndex].m_pUserData = _pUserData;
+
+	return handle;
+}
+
+TimerHandle TimerWheel::DestroyEntityAfter(EntityID _entityId, float _seconds)
+{
+	const TimerHandle handle = CreateTimer(_seconds, TimerAction::DestroyEntity);
+	m_timers[handle.m_uIndex].m_entityId = _entityId;
+
+	return handle;
+}
+
+bool TimerWheel::Cancel(TimerHandle _handle)
+{
+	if (!IsPending(_handle))
+	{
+		return false;
+	}
+
+	UnlinkTimer(_handle.m_uIndex);
+	ReleaseTimer(_handle.m_uIndex);
+	return true;
+}
+
+bool TimerWheel::IsPending(TimerHandle _handle) const
+{
+	return _handle.m_uIndex < m_timers.size()
+		&& m_timers[_handle.m_uIndex].m_uGeneration == _handle.m_uGeneration
+		&& m_timers[_handle.m_uIndex].m_isScheduled;
+}
+
+TimerHandle TimerWheel::CreateTimer(float _seconds, TimerAction _action)
+{
+	uint32_t timerIndex = m_uFirstFreeTimer;
+	if (timerIndex != INVALID_TIMER)
+	{
+		m_uFirstFreeTimer = m_timers[timerIndex].m_uNext;
+	}
+	else
+	{
+		timerIndex = static_cast<uint32_t>(m_timers.size());
+		m_timers.emplace_back();
+	}
+
+	// Always at least one tick, so a timer never fires in the same Advance that created it.
+	const double ticks = std::ceil(std::max(0.0f, _seconds) / m_tickDuration);
+	const uint64_t delayInTicks = std::clamp<uint64_t>(static_cast<uint64_t>(ticks), 1, MAX_TICKS);
+
+	Timer& timer = m_timers[timerIndex];
+	timer.m_uExpirationTick = m_uCurrentTick + delayInTicks;
+	timer.m_action = _action;
+	timer.m_callback = nullptr;
+	timer.m_pUserData = nullptr;
+	timer.m_entityId = 0;
+	timer.m_isScheduled = true;
+
+	InsertTimer(timerIndex);
+	m_uNumberOfPendingTimers++;
+
+	return TimerHandle{ timerIndex, timer.m_uGeneration };
+}
+
+void TimerWheel::InsertTimer(uint32_t _uTimerIndex)
+{
+	Timer& timer = m_timers[_uTimerIndex];
+	const uint64_t ticksLeft = timer.m_uExpirationTick - m_uCurrentTick;
+
+	// The level is the first one whose range covers the ticks left. The slot is taken from the expiration tick itself,
+	// so the timer moves down a level exactly when the lower levels have turned up to its expiration.
+	unsigned int level = 0;
+	while (level < NUMBER_OF_LEVELS - 1 && ticksLeft >= (1ull << (SLOT_BITS * (level + 1))))
+	{
+		level++;
+	}
+	const unsigned int slot = level * SLOTS_PER_LEVEL + static_cast<unsigned int>((timer.m_uExpirationTick >> (SLOT_BITS * level)) & (SLOTS_PER_LEVEL - 1));
+
+	timer.m_uSlot = static_cast<uint16_t>(slot);
+	timer.m_uPrevious = INVALID_TIMER;
+	timer.m_uNext = m_slots[slot];
+	if (m_slots[slot] != INVALID_TIMER)
+	{
+		m_timers[m_slots[slot]].m_uPrevious = _uTimerIndex;
+	}
+	m_slots[slot] = _uTimerIndex;
+}
+
+void TimerWheel::UnlinkTimer(uint32_t _uTimerIndex)
+{
+	Timer& timer = m_timers[_uTimerIndex];
+
+	if (timer.m_uPrevious != INVALID_TIMER)
+	{
+		m_timers[timer.m_uPrevious].m_uNext = timer.m_uNext;
+	}
+	else
+	{
+		m_slots[timer.m_uSlot] = timer.m_uNext;
+	}
+
+	if (timer.m_uNext != INVALID_TIMER)
+	{
+		m_timers[timer.m_uNext].m_uPrevious = timer.m_uPrevious;
+	}
+}
+
+void TimerWheel::ReleaseTimer(uint32_t _uTimerIndex)
+{
+	Timer& timer = m_timers[_uTimerIndex];
+
+	timer.m_isScheduled = false;
+	timer.m_uGeneration++;
+	timer.m_uPrevious = INVALID_TIMER;
+	timer.m_uNext = m_uFirstFreeTimer;
+	m_uFirstFreeTimer = _uTimerIndex;
+
+	m_uNumberOfPendingTimers--;
+}
+
+#pragma endregion
+
+#pragma region Advancing
+
+void TimerWheel::Advance(float _deltaTime)
+{
+	m_accumulatedTime += _deltaTime;
+
+	while (m_accumulatedTime >= m_tickDuration)
+	{
+		m_accumulatedTime -= m_tickDuration;
+		Tick();
+	}
+
+	if (!m_expiredTimers.empty())
+	{
+		FireExpiredTimers();
+	}
+}
+
+void TimerWheel::Tick()
+{
+	m_uCurrentTick++;
+
+	// Every time a level finishes a turn, the next slot of the level above is moved down.
+	for (unsigned int level = 1; level < NUMBER_OF_LEVELS; level++)
+	{
+		if ((m_uCurrentTick & ((1ull << (SLOT_BITS * level)) - 1)) != 0)
+		{
+			break;
+		}
+
+		const unsigned int slot = level * SLOTS_PER_LEVEL + static_cast<unsigned int>((m_uCurrentTick >> (SLOT_BITS * level)) & (SLOTS_PER_LEVEL - 1));
+		uint32_t timerIndex = m_slots[slot];
+		m_slots[slot] = INVALID_TIMER;
+
+		while (timerIndex != INVALID_TIMER)
+		{
+			const uint32_t nextTimerIndex = m_timers[timerIndex].m_uNext;
+			InsertTimer(timerIndex);
+			timerIndex = nextTimerIndex;
+		}
+	}
+
+	// The timers of the current slot of the first level expire now. They are fired after the wheel stops moving,
+	// so their callbacks can safely add or cancel timers.
+	const unsigned int slot = static_cast<unsigned int>(m_uCurrentTick & (SLOTS_PER_LEVEL - 1));
+	uint32_t timerIndex = m_slots[slot];
+	m_slots[slot] = INVALID_TIMER;
+
+	while (timerIndex != INVALID_TIMER)
+	{
+		Timer& timer = m_timers[timerIndex];
+		timer.m_uSlot = static_cast<uint16_t>(slot);
+		timer.m_isScheduled = false; // Can't be cancelled anymore.
+		m_expiredTimers.push_back(timerIndex);
+		timerIndex = timer.m_uNext;
+	}
+}
+
+void TimerWheel::FireExpiredTimers()
+{
+	// Swapping out the batch, since callbacks may add timers that expire in a later Advance.
+	std::vector<uint32_t> expiredTimers;
+	expiredTimers.swap(m_expiredTimers);
+
+	m_entitiesToDestroy.clear();
+
+	for (uint32_t timerIndex : expiredTimers)
+	{
+		// Copying the timer before releasing it, since the callback can reuse its slot.
+		const Timer timer = m_timers[timerIndex];
+		m_timers[timerIndex].m_isScheduled = true; // ReleaseTimer expects a pending timer.
+		ReleaseTimer(timerIndex);
+
+		switch (timer.m_action)
+		{
+		case TimerAction::Callback:
+			timer.m_callback(timer.m_pUserData);
+			break;
+		case TimerAction::DestroyEntity:
+			m_entitiesToDestroy.push_back(timer.m_entityId);
+			break;
+		}
+	}
+
+	if (!m_entitiesToDestroy.empty())
+	{
+		ECS_PoolManager* poolManager = ECS_PoolManager::GetInstance();
+		for (EntityID entityId : m_entitiesToDestroy)
+		{
+			// The version inside the ID tells us if the Entity was destroyed (and maybe its slot reused) in the meantime.
+			if (!poolManager->IsEntityDeleted(entityId))
+			{
+				poolManager->DestroyEntity(entityId);
+			}
+		}
+	}
+
+	// Keeping the capacity of the batch for the next time.
+	expiredTimers.clear();
+	if (m_expiredTimers.empty())
+	{
+		m_expiredTimers.swap(expiredTimers);
+	}
+}
+
+#pragma endregion
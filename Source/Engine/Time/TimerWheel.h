@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Engine/ECS/ECS_Typedefs.h"
+#include <cstdint>
+#include <vector>
+
+typedef void (*TimerCallback)(void* _pUserData);
+
+/// <summary>
+/// Weak reference to a timer. It stays safe to use after the timer has fired or has been cancelled.
+/// </summary>
+struct TimerHandle
+{
+	uint32_t m_uIndex{ UINT32_MAX };
+	uint32_t m_uGeneration{ 0 };
+
+	inline bool IsValid() const { return m_uIndex != UINT32_MAX; };
+};
+
+/// <summary>
+/// Hierarchical timer wheel. Timers are stored in doubly linked lists inside the slots of NUMBER_OF_LEVELS wheels,
+/// the first one with a slot per tick and every next one with a slot per full turn of the previous one.
+/// <para>Adding and cancelling a timer is O(1), and advancing a tick only touches the timers that expire or move down a level,
+/// so waiting timers cost nothing per frame. Expired timers are fired in a batch at the end of Advance, in expiration order.</para>
+/// </summary>
+class TimerWheel
+{
+public:
+	static constexpr unsigned int SLOT_BITS{ 8 };
+	static constexpr unsigned int SLOTS_PER_LEVEL{ 1u << SLOT_BITS };
+	static constexpr unsigned int NUMBER_OF_LEVELS{ 4 };
+	static constexpr uint64_t MAX_TICKS{ (1ull << (SLOT_BITS * NUMBER_OF_LEVELS)) - 1 };
+
+private:
+	static constexpr uint32_t INVALID_TIMER{ UINT32_MAX };
+
+	enum class TimerAction : unsigned char
+	{
+		Callback,
+		DestroyEntity
+	};
+
+	struct Timer
+	{
+		uint64_t m_uExpirationTick{ 0 };
+		uint32_t m_uPrevious{ INVALID_TIMER };
+		uint32_t m_uNext{ INVALID_TIMER }; // Also links the free timers.
+		uint32_t m_uGeneration{ 0 };
+		uint16_t m_uSlot{ 0 }; // Level * SLOTS_PER_LEVEL + slot, while the timer is in the wheel.
+		bool m_isScheduled{ false };
+
+		TimerAction m_action{ TimerAction::Callback };
+		TimerCallback m_callback{ nullptr };
+		void* m_pUserData{ nullptr };
+		EntityID m_entityId{ 0 };
+	};
+
+	std::vector<Timer> m_timers;
+	uint32_t m_uFirstFreeTimer{ INVALID_TIMER };
+	unsigned int m_uNumberOfPendingTimers{ 0 };
+
+	uint32_t m_slots[NUMBER_OF_LEVELS * SLOTS_PER_LEVEL];
+
+	uint64_t m_uCurrentTick{ 0 };
+	float m_tickDuration{ 1.0f / 60.0f };
+	double m_accumulatedTime{ 0 };
+
+	std::vector<uint32_t> m_expiredTimers;
+	std::vector<EntityID> m_entitiesToDestroy;
+
+public:
+	TimerWheel();
+	TimerWheel(const TimerWheel&) = delete;
+	TimerWheel& operator=(const TimerWheel&) = delete;
+
+	/// <summary>
+	/// Sets how much time a tick lasts. Timers are rounded up to whole ticks, so it should match the simulation step.
+	/// </summary>
+	void SetTickDuration(float _tickDuration);
+	inline float GetTickDuration() const { return m_tickDuration; };
+
+	/// <summary>
+	/// Calls _callback(_pUserData) once _seconds have passed.
+	/// </summary>
+	TimerHandle AddTimer(float _seconds, TimerCallback _callback, void* _pUserData = nullptr);
+	/// <summary>
+	/// Destroys the Entity once _seconds have passed, unless it has already been destroyed by then.
+	/// Entities that expire in the same Advance are destroyed together.
+	/// </summary>
+	TimerHandle DestroyEntityAfter(EntityID _entityId, float _seconds);
+
+	/// <summary>
+	/// Returns false if the timer had already fired or been cancelled.
+	/// </summary>
+	bool Cancel(TimerHandle _handle);
+	bool IsPending(TimerHandle _handle) const;
+	inline unsigned int HowManyPendingTimers() const { return m_uNumberOfPendingTimers; };
+
+	/// <summary>
+	/// Moves the wheel forward by the ticks that fit in the accumulated time and fires the timers that expired.
+	/// </summary>
+	void Advance(float _deltaTime);
+
+private:
+	TimerHandle CreateTimer(float _seconds, TimerAction _action);
+	void InsertTimer(uint32_t _uTimerIndex);
+	void UnlinkTimer(uint32_t _uTimerIndex);
+	void ReleaseTimer(uint32_t _uTimerIndex);
+	void Tick();
+	void FireExpiredTimers();
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+// Picking the widest instruction set the compiler has been allowed to use, like ECS_ComponentMask does.
+#if defined(__AVX2__) || defined(__AVX__)
+#define SIMD_USE_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+/// <summary>
+/// Thin wrappers over a register of floats, so a kernel is written once as a template and instantiated with the widest lanes available
+/// (WideLanes) plus single floats (ScalarLanes) for the tail of its arrays.
+/// <para>Compare functions return lanes with every bit set where the comparison holds, to be combined with &amp; and | and consumed by Select.
+/// LessMask and GreaterOrEqualMask pack the result of the comparison in the low bits of an integer instead.</para>
+/// </summary>
+namespace SIMD
+{
+#if defined(SIMD_USE_AVX)
+	struct SimdLanes
+	{
+		static constexpr uint32_t WIDTH{ 8 };
+		__m256 m_value;
+
+		static inline SimdLanes Load(const float* _pValues) { return { _mm256_loadu_ps(_pValues) }; };
+		static inline SimdLanes Set(float _value) { return { _mm256_set1_ps(_value) }; };
+		inline void Store(float* _pValues) const { _mm256_storeu_ps(_pValues, m_value); };
+	};
+	inline SimdLanes operator+(SimdLanes _a, SimdLanes _b) { return { _mm256_add_ps(_a.m_value, _b.m_value) }; };
+	inline SimdLanes operator-(SimdLanes _a, SimdLanes _b) { return { _mm256_sub_ps(_a.m_value, _b.m_value) }; };
+	inline SimdLanes operator*(SimdLanes _a, SimdLanes _b) { return { _mm256_mul_ps(_a.m_value, _b.m_value) }; };
+	inline SimdLanes operator&(SimdLanes _a, SimdLanes _b) { return { _mm256_and_ps(_a.m_value, _b.m_value) }; };
+	inline SimdLanes operator|(SimdLanes _a, SimdLanes _b) { return { _mm256_or_ps(_a.m_value, _b.m_value) }; };
+	inline SimdLanes Min(SimdLanes _a, SimdLanes _b) { return { _mm256_min_ps(_a.m_value, _b.m_value) }; };
+	inline SimdLanes Max(SimdLanes _a, SimdLanes _b) { return { _mm256_max_ps(_a.m_value, _b.m_value) }; };
+	inline SimdLanes Abs(SimdLanes _a) { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), _a.m_value) }; };
+	inline SimdLanes CompareLess(SimdLanes _a, SimdLanes _b) { return { _mm256_cmp_ps(_a.m_value, _b.m_value, _CMP_LT_OQ) }; };
+	inline SimdLanes CompareGreater(SimdLanes _a, SimdLanes _b) { return { _mm256_cmp_ps(_a.m_value, _b.m_value, _CMP_GT_OQ) }; };
+	// _a where _mask is set, _b everywhere else.
+	inline SimdLanes Select(SimdLanes _mask, SimdLanes _a, SimdLanes _b) { return { _mm256_blendv_ps(_b.m_value, _a.m_value, _mask.m_value) }; };
+	inline uint32_t LessMask(SimdLanes _a, SimdLanes _b) { return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(_a.m_value, _b.m_value, _CMP_LT_OQ))); };
+	inline uint32_t GreaterOrEqualMask(SimdLanes _a, SimdLanes _b) { return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(_a.m_value, _b.m_value, _CMP_GE_OQ))); };
+#elif defined(SIMD_USE_SSE2)
+	struct SimdLanes
+	{
+		static constexpr uint32_t WIDTH{ 4 };
+		__m128 m_value;
+
+		static inline SimdLanes Load(const float* _pValues) { return { _mm_loadu_ps(_pValues) }; };
+		static inline SimdLanes Set(float _value) { return { _mm_set1_ps(_value) }; };
+		inline void Store(float* _pValues) const { _mm_storeu_ps(_pValues, m_value); };
+	};
+	inline SimdLanes operator+(SimdLanes _a, SimdLanes _b) { return { _mm_add_ps(_a.m_value, _b.m_value) }; };
+	inline SimdLanes operator-(SimdLanes _a, SimdLanes _b) { return { _mm_sub_ps(_a.m_value, _b.m_value) }; };
+	inline SimdLanes operator*(SimdLanes _a, SimdLanes _b) { return { _mm_mul_ps(_a.m_value, _b.m_value) }; };
+	inline SimdLanes operator&(SimdLanes _a, SimdLanes _b) { return { _mm_and_ps(_a.m_value, _b.m_value) }; };
+	inline SimdLanes operator|(SimdLanes _a, SimdLanes _b) { return { _mm_or_ps(_a.m_value, _b.m_value) }; };
+	inline SimdLanes Min(SimdLanes _a, SimdLanes _b) { return { _mm_min_ps(_a.m_value, _b.m_value) }; };
+	inline SimdLanes Max(SimdLanes _a, SimdLanes _b) { return { _mm_max_ps(_a.m_value, _b.m_value) }; };
+	inline SimdLanes Abs(SimdLanes _a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), _a.m_value) }; };
+	inline SimdLanes CompareLess(SimdLanes _a, SimdLanes _b) { return { _mm_cmplt_ps(_a.m_value, _b.m_value) }; };
+	inline SimdLanes CompareGreater(SimdLanes _a, SimdLanes _b) { return { _mm_cmpgt_ps(_a.m_value, _b.m_value) }; };
+	// SSE2 has no blend instruction.
+	inline SimdLanes Select(SimdLanes _mask, SimdLanes _a, SimdLanes _b) { return { _mm_or_ps(_mm_and_ps(_mask.m_value, _a.m_value), _mm_andnot_ps(_mask.m_value, _b.m_value)) }; };
+	inline uint32_t LessMask(SimdLanes _a, SimdLanes _b) { return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmplt_ps(_a.m_value, _b.m_value))); };
+	inline uint32_t GreaterOrEqualMask(SimdLanes _a, SimdLanes _b) { return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpge_ps(_a.m_value, _b.m_value))); };
+#endif
+
+	struct ScalarLanes
+	{
+		static constexpr uint32_t WIDTH{ 1 };
+		float m_value;
+
+		static inline ScalarLanes Load(const float* _pValues) { return { *_pValues }; };
+		static inline ScalarLanes Set(float _value) { return { _value }; };
+		inline void Store(float* _pValues) const { *_pValues = m_value; };
+	};
+	inline ScalarLanes operator+(ScalarLanes _a, ScalarLanes _b) { return { _a.m_value + _b.m_value }; };
+	inline ScalarLanes operator-(ScalarLanes _a, ScalarLanes _b) { return { _a.m_value - _b.m_value }; };
+	inline ScalarLanes operator*(ScalarLanes _a, ScalarLanes _b) { return { _a.m_value * _b.m_value }; };
+	inline ScalarLanes operator&(ScalarLanes _a, ScalarLanes _b) { return { std::bit_cast<float>(std::bit_cast<uint32_t>(_a.m_value) & std::bit_cast<uint32_t>(_b.m_value)) }; };
+	inline ScalarLanes operator|(ScalarLanes _a, ScalarLanes _b) { return { std::bit_cast<float>(std::bit_cast<uint32_t>(_a.m_value) | std::bit_cast<uint32_t>(_b.m_value)) }; };
+	inline ScalarLanes Min(ScalarLanes _a, ScalarLanes _b) { return { _a.m_value < _b.m_value ? _a.m_value : _b.m_value }; };
+	inline ScalarLanes Max(ScalarLanes _a, ScalarLanes _b) { return { _a.m_value > _b.m_value ? _a.m_value : _b.m_value }; };
+	inline ScalarLanes Abs(ScalarLanes _a) { return { std::fabs(_a.m_value) }; };
+	inline ScalarLanes CompareLess(ScalarLanes _a, ScalarLanes _b) { return { std::bit_cast<float>(_a.m_value < _b.m_value ? 0xFFFFFFFFu : 0u) }; };
+	inline ScalarLanes CompareGreater(ScalarLanes _a, ScalarLanes _b) { return { std::bit_cast<float>(_a.m_value > _b.m_value ? 0xFFFFFFFFu : 0u) }; };
+	inline ScalarLanes Select(ScalarLanes _mask, ScalarLanes _a, ScalarLanes _b) { return std::bit_cast<uint32_t>(_mask.m_value) != 0 ? _a : _b; };
+	inline uint32_t LessMask(ScalarLanes _a, ScalarLanes _b) { return _a.m_value < _b.m_value ? 1u : 0u; };
+	inline uint32_t GreaterOrEqualMask(ScalarLanes _a, ScalarLanes _b) { return _a.m_value >= _b.m_value ? 1u : 0u; };
+
+#if defined(SIMD_USE_AVX) || defined(SIMD_USE_SSE2)
+	typedef SimdLanes WideLanes;
+#else
+	typedef ScalarLanes WideLanes;
+#endif
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace MEMORY_UTIL
+{
+	/// <summary>
+	/// Heap bytes owned by a string. Short strings are stored inside the object itself (small string optimization) and own nothing.
+	/// </summary>
+	static inline size_t GetHeapMemoryUsage(const std::string& _String)
+	{
+		return _String.capacity() > std::string().capacity() ? _String.capacity() + 1 : 0;
+	}
+
+	/// <summary>
+	/// Heap bytes owned by the vector buffer. It does not follow pointers stored inside the vector.
+	/// </summary>
+	template<typename T>
+	static inline size_t GetHeapMemoryUsage(const std::vector<T>& _Vector)
+	{
+		return _Vector.capacity() * sizeof(T);
+	}
+}
@@ -5,6 +5,7 @@
 #include "Engine/DataTypes/Vectors/vector3d.h"
 #include "Engine/DataTypes/Vectors/vector4d.h"
 #include "Engine/DataTypes/Vectors/color.h"
+#include <cstdint>
 #include <string>
 
 namespace XML_UTIL
@@ -81,6 +82,12 @@ namespace XML_UTIL
 		_VariableToFill = static_cast<T>(std::stof(_Component.attribute("Value").value()));
 	}
 	template<>
+	static void LoadXMLNodeToVariable(uint32_t& _UIntToFill, const pugi::xml_node& _Component)
+	{
+		// Through a float, bit masks above 2^24 would lose their lower bits.
+		_UIntToFill = static_cast<uint32_t>(std::stoul(_Component.attribute("Value").value()));
+	}
+	template<>
 	static void LoadXMLNodeToVariable(bool& _BoolToFill, const pugi::xml_node& _Component)
 	{
 		_BoolToFill = (_Component.attribute("Value").value() == std::string("True"));
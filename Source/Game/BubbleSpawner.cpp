@@ -1,43 +1,64 @@
 #include "BubbleSpawner.h"
+#include "Engine/Engine.h"
 #include "Engine/ECS/ECS_PoolManager.h"
 #include "Engine/Components/Rigidbody/C_RigidBody2D.h"
+#include "Engine/Util/Memory/Memory_Util.h"
 
-void BubbleSpawner::Update(float _DeltaTime)
+BubbleSpawner::BubbleSpawner()
 {
-	BubbleSpawnTimer -= _DeltaTime;
+	// The Behaviour is destroyed together with the Component, which happens when the game ends.
+	SpawnBehaviour = SpawnBubbles();
+	ECS_PoolManager::GetInstance()->StartBehaviour(SpawnBehaviour);
+}
+
+ECS_Behaviour BubbleSpawner::SpawnBubbles()
+{
+	while (true)
+	{
+		SpawnRandomBubble();
+		co_await WaitSeconds(MaxTimer);
+	}
+}
+
+void BubbleSpawner::SpawnRandomBubble()
+{
+	int whichBubbleToSpawn = rand() % 3;
+
+	EntityID spawnedEntity;
+
+	if (whichBubbleToSpawn == 0)
+	{
+		spawnedEntity = BlueBubblePrefab.Instantiate();
+	}
+	else if (whichBubbleToSpawn == 1)
+	{
+		spawnedEntity = GreenBubblePrefab.Instantiate();
+	}
+	else
+	{
+		spawnedEntity = RedBubblePrefab.Instantiate();
+	}
 
-	if (BubbleSpawnTimer <= 0)
+	// If our spawn was successful.
+	if (spawnedEntity != ECS::CONSTANTS::InvalidEntityID())
 	{
-		BubbleSpawnTimer = MaxTimer;
-		int whichBubbleToSpawn = rand() % 3;
-
-		EntityID spawnedEntity;
-
-		if (whichBubbleToSpawn == 0)
-		{
-			spawnedEntity = BlueBubblePrefab.Instantiate();
-		}
-		else if (whichBubbleToSpawn == 1)
-		{
-			spawnedEntity = GreenBubblePrefab.Instantiate();
-		}
-		else
-		{
-			spawnedEntity = RedBubblePrefab.Instantiate();
-		}
-
-		// If our spawn was successful.
-		if (spawnedEntity != ECS::CONSTANTS::InvalidEntityID())
-		{
-			ECS_PoolManager* manager = ECS_PoolManager::GetInstance();
-			ECS_EntityPool* pool = manager->GetEntityPool(ECS::GetPoolFromId(spawnedEntity));
-
-			// Placing the Entity in a random starting position.
-			pool->GetComponent<C_Transform2D>(spawnedEntity)->m_pos.x = (rand() % 85) * 5;
-			pool->GetComponent<C_Transform2D>(spawnedEntity)->m_pos.y = 70 + (rand() % 20) * 4;
-
-			// Giving more diversity by switching direction of initial X Velocity.
-			pool->GetComponent<C_Rigidbody2D>(spawnedEntity)->m_velocity.x *= (rand() % 2) ? 1 : -1;
-		}
+		ECS_PoolManager* manager = ECS_PoolManager::GetInstance();
+		ECS_EntityPool* pool = manager->GetEntityPool(ECS::GetPoolFromId(spawnedEntity));
+
+		// Placing the Entity in a random starting position.
+		pool->GetComponent<C_Transform2D>(spawnedEntity)->Teleport(vec2((rand() % 85) * 5, 70 + (rand() % 20) * 4));
+
+		// Giving more diversity by switching direction of initial X Velocity.
+		pool->GetComponent<C_Rigidbody2D>(spawnedEntity)->m_velocity.x *= (rand() % 2) ? 1 : -1;
+
+		// If the game ends first, the Bubble is destroyed with the rest and the timer finds it already gone.
+		Engine::GetInstance()->GetTimerWheel()->DestroyEntityAfter(spawnedEntity, BubbleLifetime);
 	}
 }
+
+size_t BubbleSpawner::GetHeapMemoryUsage() const
+{
+	return MEMORY_UTIL::GetHeapMemoryUsage(BlueBubblePrefabPath) + MEMORY_UTIL::GetHeapMemoryUsage(BlueBubblePrefab.GetPrefabPath())
+		+ MEMORY_UTIL::GetHeapMemoryUsage(GreenBubblePrefabPath) + MEMORY_UTIL::GetHeapMemoryUsage(GreenBubblePrefab.GetPrefabPath())
+		+ MEMORY_UTIL::GetHeapMemoryUsage(RedBubblePrefabPath) + MEMORY_UTIL::GetHeapMemoryUsage(RedBubblePrefab.GetPrefabPath());
+}
@@ -1,10 +1,11 @@
 #pragma once
 
 #include "Engine/ECS/ECS_Interfaces.h"
+#include "Engine/ECS/ECS_BehaviourScheduler.h"
 #include "Engine/DataTypes/Prefabs/Prefab.h"
 #include <string>
 
-struct BubbleSpawner : IECS_Update
+struct BubbleSpawner : IECS_HeapMemory
 {
 	const std::string BlueBubblePrefabPath = std::string("Assets/Prefabs/BlueBubblePrefab.xml");
 	const std::string GreenBubblePrefabPath = std::string("Assets/Prefabs/GreenBubblePrefab.xml");
@@ -14,8 +15,14 @@ struct BubbleSpawner : IECS_Update
 	const Prefab GreenBubblePrefab = Prefab(GreenBubblePrefabPath);
 	const Prefab RedBubblePrefab = Prefab(RedBubblePrefabPath);
 
-	float BubbleSpawnTimer = 0.0f;
 	const float MaxTimer = 5.0f;
+	const float BubbleLifetime = 40.0f; // Keeps the Bubble Pool from filling up in long runs.
 
-	void Update(float _DeltaTime);
+	ECS_Behaviour SpawnBehaviour;
+
+	BubbleSpawner();
+
+	ECS_Behaviour SpawnBubbles();
+	void SpawnRandomBubble();
+	size_t GetHeapMemoryUsage() const;
 };
\ No newline at end of file
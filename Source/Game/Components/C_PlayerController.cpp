@@ -5,6 +5,7 @@
 #include "Engine/Components/Rendering/C_TextureRenderer.h"
 #include "Game/BubbleSpawner.h"
 #include "Game/GameScoreCounter.h"
+#include "Game/GameEvents.h"
 
 C_PlayerController::C_PlayerController()
 {
@@ -71,6 +72,17 @@ void C_PlayerController::MovePlayer(float _DeltaTime)
 
 void C_PlayerController::Update(float _DeltaTime)
 {
+	// Hits of the last physics steps. Several balls can hit in the same step, but the game only ends once.
+	bool wasHit = false;
+	ECS_PoolManager::GetInstance()->GetEventBus()->Drain<PlayerHitEvent>([this, &wasHit](const PlayerHitEvent& _event)
+		{
+			wasHit = wasHit || _event.m_playerEntityId == OwnerEntityId;
+		});
+	if (wasHit)
+	{
+		TryToEndGame();
+	}
+
 	if (window != nullptr)
 	{
 		// Recording inputs
@@ -133,7 +145,7 @@ void C_PlayerController::TryToRestartGame()
 	C_Transform2D* playerTransform = poolManager->GetEntityPool(ECS::GetPoolFromId(GetPlayerEntityID()))->GetComponent<C_Transform2D>(GetPlayerEntityID());
 	if (playerTransform != nullptr)
 	{
-		playerTransform->m_pos.x = 150;
+		playerTransform->Teleport(vec2(150, playerTransform->m_pos.y));
 	}
 
 	// Enabling the BubbleSpawner.
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "Engine/ECS/ECS_EntityID.h"
+
+/// <summary>
+/// A ball touched the Player. Published by S_BallCollisions and consumed by the C_PlayerController, which ends the game.
+/// </summary>
+struct PlayerHitEvent
+{
+	EntityID m_playerEntityId{ ECS::CONSTANTS::InvalidEntityID() };
+};
@@ -1,7 +1,7 @@
 #include "GameScoreCounter.h"
 #include "Engine/Util/XML/XML_File_Handler.h"
 #include "Engine/ExternalLibraries/Tigr/tigr.h"
-#include "Engine/Engine.h"
+#include "Engine/Util/Memory/Memory_Util.h"
 
 void GameScoreCounter::StartNewRun()
 {
@@ -29,20 +29,20 @@ void GameScoreCounter::Update(float _DeltaTime)
 	}
 }
 
-void GameScoreCounter::RenderDebugText()
+void GameScoreCounter::RenderDebugText(RenderQueue& _RenderQueue)
 {
 	if(RunStarted)
 	{
 		// Showcasing the current Score.
-		tigrPrint(Engine::GetInstance()->GetTigrScreen(), tfont, 300, 20, tigrRGBA(0xff, 0xff, 0xff, 0xff), "Current Score : %f", CurrentScore);
+		_RenderQueue.AddText(300, 20, tigrRGBA(0xff, 0xff, 0xff, 0xff), "Current Score : %f", CurrentScore);
 	}
 	else
 	{
 		// We showcase a prompt to start the game with Space.
-		tigrPrint(Engine::GetInstance()->GetTigrScreen(), tfont, 300, 20, tigrRGBA(0xff, 0xff, 0xff, 0xff), "Press SPACE to restart.");
+		_RenderQueue.AddText(300, 20, tigrRGBA(0xff, 0xff, 0xff, 0xff), "Press SPACE to restart.");
 	}
 
-	tigrPrint(Engine::GetInstance()->GetTigrScreen(), tfont, 15, 20, tigrRGBA(0xff, 0xff, 0xff, 0xff), "Best Score : %f", BestScore);
+	_RenderQueue.AddText(15, 20, tigrRGBA(0xff, 0xff, 0xff, 0xff), "Best Score : %f", BestScore);
 }
 
 bool GameScoreCounter::Serialize(pugi::xml_node* _ComponentNode)
@@ -90,3 +90,8 @@ bool GameScoreCounter::Load(const pugi::xml_node* _ComponentNode)
 
 	return true;
 }
+
+size_t GameScoreCounter::GetHeapMemoryUsage() const
+{
+	return MEMORY_UTIL::GetHeapMemoryUsage(ScoresFilePath);
+}
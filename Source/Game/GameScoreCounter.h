@@ -1,10 +1,11 @@
 #pragma once
 
 #include "Engine/ECS/ECS_Interfaces.h"
+#include "Engine/Rendering/RenderQueue.h"
 #include "Engine/ExternalLibraries/Pugixml/pugixml.hpp"
 #include <string>
 
-struct GameScoreCounter : IECS_Update, IECS_Serializable
+struct GameScoreCounter : IECS_Update, IECS_ThreadSafeUpdate, IECS_Serializable, IECS_HeapMemory
 {
 private:
 	const std::string ScoresFilePath = std::string("Assets/SaveFiles/Scores.xml");
@@ -19,8 +20,10 @@ public:
 	void EndRun();
 
 	void Update(float _DeltaTime);
-	void RenderDebugText();
+	void RenderDebugText(RenderQueue& _RenderQueue);
 
 	bool Serialize(pugi::xml_node* _ComponentNode);
 	bool Load(const pugi::xml_node* _ComponentNode);
+
+	size_t GetHeapMemoryUsage() const;
 };
\ No newline at end of file
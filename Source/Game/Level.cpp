@@ -1,6 +1,7 @@
 #include "Game/Level.h"
 #include "Engine/Util/XML/XML_File_Handler.h"
 #include "Engine/ECS/ECS_PoolManager.h"
+#include "Engine/Engine.h"
 #include "Engine/DataTypes/Prefabs/Prefab.h"
 
 Level::Level(const std::string& _LevelPath)
@@ -133,5 +134,11 @@ bool Level::Instantiate()
 		prefab.Instantiate();
 	}
 
+	// The level geometry is static, so its tree is built once here instead of during the first step.
+	if (const Engine* engine = Engine::GetInstance())
+	{
+		engine->GetCollisionPipeline()->GetBroadphase()->RebuildStaticColliders(poolManager);
+	}
+
 	return true;
 }
@@ -6,4 +6,6 @@ class PoolInitializationClass : public ECS_Pool_Initializer
 {
 public:
 	virtual void InitializeECSPools(ECS_PoolManager* _PoolManager) override;
+	virtual void InitializeEvents(EventBus* _EventBus) override;
+	virtual void InitializeECSSystems(ECS_PoolManager* _PoolManager) override;
 };
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include "S_BallCollisions.h"
+#include "Engine/Engine.h"
+#include "Game/GameEvents.h"
+
+void S_BallCollisions::Update(ECS_PoolManager* _PoolManager, float /*_deltaTime*/)
+{
+	EntityID playerEntityID = ECS::CONSTANTS::InvalidEntityID();
+	if (C_PlayerController* playerController = C_PlayerController::GetInstance())
+	{
+		playerEntityID = playerController->GetPlayerEntityID();
+	}
+
+	if (playerEntityID == ECS::CONSTANTS::InvalidEntityID())
+	{
+		return;
+	}
+
+	// Looking for a ball that started touching the player this step. Balls that were already touching it have published their event.
+	for (const ContactEvent& contactEvent : Engine::GetInstance()->GetCollisionPipeline()->GetContactEvents())
+	{
+		if (contactEvent.m_type != ContactEventType::Begin || (contactEvent.m_entityA != playerEntityID && contactEvent.m_entityB != playerEntityID))
+		{
+			continue;
+		}
+
+		const EntityID otherEntityID = contactEvent.m_entityA == playerEntityID ? contactEvent.m_entityB : contactEvent.m_entityA;
+		const ECS_EntityPool* otherPool = _PoolManager->GetEntityPool(ECS::GetPoolFromId(otherEntityID));
+		if (otherPool->HasComponentBeenInitialized<C_BallController>() && otherPool->HasComponentEnabled<C_BallController>(otherEntityID))
+		{
+			_PoolManager->GetEventBus()->Publish(PlayerHitEvent{ playerEntityID });
+			break;
+		}
+	}
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Engine/ECS/ECS_Interfaces.h"
+#include "Engine/ECS/ECS_SystemScheduler.h"
+#include "Game/Components/C_BallController.h"
+#include "Game/Components/C_PlayerController.h"
+
+/// <summary>
+/// Publishes a PlayerHitEvent when a ball starts touching the Player. The balls bounce off the edges of the screen through their Bounds Constraint.
+/// </summary>
+struct S_BallCollisions : IECS_System
+{
+	// The Player Controller ends the game when it drains the event, so this System doesn't touch the game state.
+	using Reads = ECS_ComponentList<C_BallController, C_PlayerController>;
+	using Writes = ECS_ComponentList<>;
+
+	void Update(ECS_PoolManager* _PoolManager, float _deltaTime);
+};
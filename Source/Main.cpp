@@ -5,12 +5,19 @@
 //
 
 #include "Engine/Engine.h"
+#include "Engine/Systems/S_RigidbodyIntegration.h"
 #include "Game/PoolInitializationClass.h"
 #include "Game/Level.h"
 #include "Game/GameScoreCounter.h"
 
 int main()
 {
+	if constexpr (Engine::RunIntegrationBenchmark)
+	{
+		S_RigidbodyIntegration::RunBenchmark();
+		return 0;
+	}
+
 	Engine engine;
 	PoolInitializationClass poolInitClass;
 
@@ -27,26 +34,30 @@ int main()
 		{
 			engine.UpdateDeltaTime();
 
-			// Updating the physics.
-			engine.UpdatePhysics();
+			// Simulating as many steps as the time of this frame requires.
+			while (engine.StepSimulation())
+			{
+				// Updating the physics.
+				engine.UpdatePhysics();
 
-			// Updating the components.
-			engine.UpdateLogic();
+				// Updating the components.
+				engine.UpdateLogic();
+			}
 
-			// Rendering our entities.
-			engine.ClearScreen();
-			engine.GetPoolManager()->RenderEntities();
+			// Rendering our entities. With pipelined rendering, the state built here is drawn while the next frame is simulated.
+			engine.BuildRenderState();
 
-			// Rendering the debug text for the Score Counter. This is necessary cause the ECS was not build to allow for multiple render passes.
-			engine.GetPoolManager()->GetEntityPool(0)->GetComponent<GameScoreCounter>(engine.GetPoolManager()->GetEntityPool(0)->m_entities[0].m_id)->RenderDebugText();
+			// Adding the debug text of the Score Counter to the render state, so it's drawn with the sprites of the same frame.
+			// This is necessary cause the ECS was not build to allow for multiple render passes.
+			engine.GetPoolManager()->GetEntityPool(0)->GetComponent<GameScoreCounter>(engine.GetPoolManager()->GetEntityPool(0)->m_entities[0].m_id)->RenderDebugText(engine.GetBuildRenderState());
 
+			engine.FinishRendering();
 			engine.UpdateTigrScreen();
 
+			engine.StartRendering();
+
 			// Limiting the Frame Rate to the desired ammount.
-			if (engine.CalculateUnscaledDeltaTimeSinceBeginningOfFrame() < 1 / Engine::FPS_Target)
-			{
-				engine.Wait(1 / Engine::FPS_Target - engine.CalculateUnscaledDeltaTimeSinceBeginningOfFrame());
-			}
+			engine.LimitFrameRate();
 		}
 
 		engine.Quit();